@@ -2,10 +2,16 @@
 
 #include <benchmark/benchmark.h>
 
+#include "msd/mpmc_channel.hpp"
+#include "msd/sharded_channel.hpp"
+#include "msd/spsc_channel.hpp"
+#include "msd/static_channel.hpp"
+
 #include <array>
 #include <cstddef>
 #include <string>
 #include <thread>
+#include <vector>
 
 // clang-format off
 /**
@@ -136,6 +142,66 @@ static void bench_static_storage(benchmark::State& state)
     }
 }
 
+template <typename Channel, typename Input>
+static void bench_channel(benchmark::State& state)
+{
+    const auto input = Input::make();
+
+    for (auto _ : state) {
+        Channel channel{};
+
+        std::thread producer([&] {
+            for (std::size_t i = 0; i < number_of_inputs; ++i) {
+                channel << input;
+            }
+            channel.close();
+        });
+
+        for (auto& value : channel) {
+            volatile auto* do_not_optimize = &value;
+            (void)do_not_optimize;
+        }
+
+        producer.join();
+    }
+}
+
+template <typename Channel>
+static void bench_many_threads(benchmark::State& state)
+{
+    const auto threads = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        Channel channel{};
+
+        std::vector<std::thread> producers;
+        for (std::size_t p = 0; p < threads; ++p) {
+            producers.emplace_back([&] {
+                for (std::size_t i = 0; i < number_of_inputs / threads; ++i) {
+                    channel << static_cast<int>(i);
+                }
+            });
+        }
+
+        std::vector<std::thread> consumers;
+        for (std::size_t c = 0; c < threads; ++c) {
+            consumers.emplace_back([&] {
+                for (auto& value : channel) {
+                    benchmark::DoNotOptimize(value);
+                }
+            });
+        }
+
+        for (auto& producer : producers) {
+            producer.join();
+        }
+        channel.close();
+        for (auto& consumer : consumers) {
+            consumer.join();
+        }
+    }
+}
+
 #define BENCH(...)                                                                               \
     BENCHMARK_TEMPLATE(__VA_ARGS__)->ComputeStatistics("max", [](const std::vector<double>& v) { \
         return *std::max_element(v.begin(), v.end());                                            \
@@ -143,14 +209,34 @@ static void bench_static_storage(benchmark::State& state)
 
 BENCH(bench_dynamic_storage, std::string, msd::queue_storage<std::string>, string_input<100000>);
 BENCH(bench_dynamic_storage, std::string, msd::vector_storage<std::string>, string_input<100000>);
+BENCH(bench_dynamic_storage, std::string, msd::dynamic_ring_storage<std::string>, string_input<100000>);
+BENCH(bench_dynamic_storage, std::string, msd::segmented_storage<std::string>, string_input<100000>);
 BENCH(bench_static_storage, std::string, msd::array_storage<std::string, channel_capacity>, string_input<100000>);
 
 BENCH(bench_dynamic_storage, std::string, msd::queue_storage<std::string>, string_input<1000>);
 BENCH(bench_dynamic_storage, std::string, msd::vector_storage<std::string>, string_input<1000>);
+BENCH(bench_dynamic_storage, std::string, msd::dynamic_ring_storage<std::string>, string_input<1000>);
+BENCH(bench_dynamic_storage, std::string, msd::segmented_storage<std::string>, string_input<1000>);
+BENCH(bench_dynamic_storage, std::string, msd::priority_storage<std::string>, string_input<1000>);
 BENCH(bench_static_storage, std::string, msd::array_storage<std::string, channel_capacity>, string_input<1000>);
+BENCH(bench_static_storage, std::string, msd::ring_storage<std::string, channel_capacity>, string_input<1000>);
 
 BENCH(bench_dynamic_storage, data, msd::queue_storage<data>, struct_input);
 BENCH(bench_dynamic_storage, data, msd::vector_storage<data>, struct_input);
+BENCH(bench_dynamic_storage, data, msd::dynamic_ring_storage<data>, struct_input);
+BENCH(bench_dynamic_storage, data, msd::segmented_storage<data>, struct_input);
 BENCH(bench_static_storage, data, msd::array_storage<data, channel_capacity>, struct_input);
+BENCH(bench_static_storage, data, msd::ring_storage<data, channel_capacity>, struct_input);
+
+BENCH(bench_channel, msd::spsc_channel<std::string, channel_capacity>, string_input<1000>);
+BENCH(bench_channel, msd::mpmc_channel<std::string, channel_capacity>, string_input<1000>);
+BENCH(bench_channel, msd::spsc_channel<data, channel_capacity>, struct_input);
+BENCH(bench_channel, msd::mpmc_channel<data, channel_capacity>, struct_input);
+BENCH(bench_many_threads, msd::mpmc_channel<int, channel_capacity>)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+BENCH(bench_channel, msd::sharded_channel<std::string>, string_input<1000>);
+BENCH(bench_channel, msd::sharded_channel<data>, struct_input);
+
+BENCH(bench_channel, msd::static_channel<std::string, channel_capacity, msd::backoff_wait<>>, string_input<1000>);
+BENCH(bench_channel, msd::static_channel<data, channel_capacity, msd::backoff_wait<>>, struct_input);
 
 BENCHMARK_MAIN();
@@ -0,0 +1,72 @@
+#include <msd/channel.hpp>
+#include <msd/executor.hpp>
+
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <thread>
+
+struct message {
+    int value;
+};
+
+// The pipeline of concurrent_map_filter.cpp, with the map and filter stages running on a fixed set of threads
+// instead of a thread for each stage.
+
+int main()
+{
+    msd::channel<message> input_chan{15};
+    msd::channel<int> mapped_chan{10};
+    msd::channel<int> filtered_chan{10};
+
+    msd::executor executor{2};
+
+    // Map from message type to int, on up to three workers at the same time
+    std::future<void> map = executor.transform(
+        input_chan, mapped_chan,
+        [](const message& msg) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));  // simulate work
+
+            return msg.value + 1;
+        },
+        3);
+
+    // Filter mapped values; a filter writes only some values, so it runs as a for_each stage
+    std::future<void> filter = executor.for_each(mapped_chan, [&filtered_chan](int value) {
+        if (value % 2 == 0) {
+            filtered_chan << value;
+        }
+    });
+
+    // The channel is closed when the filter stage finished
+    std::future<void> close_filtered = std::async([&filter, &filtered_chan]() {
+        filter.wait();
+        filtered_chan.close();
+    });
+
+    // Produce messages
+    std::thread producer{[&input_chan]() {
+        for (int i = 1; i <= 40; ++i) {
+            input_chan << message{i};
+        }
+        input_chan.close();
+    }};
+
+    int sum{};
+    for (const int value : filtered_chan) {
+        sum += value;
+    }
+
+    producer.join();
+    map.get();
+    filter.get();
+    close_filtered.wait();
+
+    const int expected = 420;
+    if (sum != expected) {
+        std::cerr << "Error: result is " << sum << ", expected " << expected << '\n';
+        std::terminate();
+    }
+
+    std::cout << "Sum of filtered values: " << sum << '\n';
+}
@@ -0,0 +1,763 @@
+// Copyright (C) 2020-2025 Andrei Avram
+
+#ifndef MSD_CHANNEL_ASYNC_HPP_
+#define MSD_CHANNEL_ASYNC_HPP_
+
+#include "status.hpp"
+
+#include <exception>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#if (__cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)) && defined(__has_include)
+#if __has_include(<coroutine>) && defined(__cpp_impl_coroutine)
+#include <coroutine>
+#include <optional>
+#define MSD_CHANNEL_HAS_COROUTINES
+#endif
+#endif
+
+/** @file */
+
+namespace msd {
+
+namespace detail {
+
+/**
+ * @brief Read or write queued on a channel, completed by the thread whose operation makes it possible.
+ *
+ * @details The channel sets the status with its lock held, then calls complete() after releasing the lock. After
+ * complete() is called, the channel does not touch the operation anymore, so complete() may destroy it. complete()
+ * may throw if it cannot hand the result over (eg: posting to an executor fails to allocate); the exception is thrown
+ * to the caller of the channel operation that completed it.
+ */
+class async_op {
+   public:
+    /**
+     * @brief Next operation in the same queue.
+     */
+    async_op* next{};
+
+    /**
+     * @brief Result of the operation: channel_status::kOk or channel_status::kClosed.
+     */
+    channel_status status{channel_status::kOk};
+
+    /**
+     * @brief Called once the operation completed, without the channel locked.
+     */
+    virtual void complete() = 0;
+
+   protected:
+    async_op() = default;
+    async_op(const async_op&) = default;
+    async_op& operator=(const async_op&) = default;
+    virtual ~async_op() = default;
+};
+
+/**
+ * @brief Asynchronous read: the channel moves the element to **out**.
+ *
+ * @tparam T The type of the elements.
+ */
+template <typename T>
+class async_read_op : public async_op {
+   public:
+    /**
+     * @brief Where the element is moved.
+     */
+    T* out{};
+
+   protected:
+    async_read_op() = default;
+    async_read_op(const async_read_op&) = default;
+    async_read_op& operator=(const async_read_op&) = default;
+    ~async_read_op() override = default;
+};
+
+/**
+ * @brief Asynchronous write: the channel moves the element from **in**.
+ *
+ * @tparam T The type of the elements.
+ */
+template <typename T>
+class async_write_op : public async_op {
+   public:
+    /**
+     * @brief The element to write.
+     */
+    T* in{};
+
+   protected:
+    async_write_op() = default;
+    async_write_op(const async_write_op&) = default;
+    async_write_op& operator=(const async_write_op&) = default;
+    ~async_write_op() override = default;
+};
+
+/**
+ * @brief FIFO queue of asynchronous operations of the same kind.
+ *
+ * @tparam Op The type of the operations.
+ */
+template <typename Op>
+struct async_queue {
+    /**
+     * @brief First operation in the queue.
+     */
+    Op* head{};
+
+    /**
+     * @brief Last operation in the queue.
+     */
+    Op* tail{};
+
+    /**
+     * @brief Checks if the queue is empty.
+     *
+     * @return true If there is no operation in the queue.
+     */
+    bool empty() const noexcept { return head == nullptr; }
+
+    /**
+     * @brief Adds an operation to the back of the queue.
+     *
+     * @param op The operation to add.
+     */
+    void push(Op& op) noexcept
+    {
+        op.next = nullptr;
+        if (tail != nullptr) {
+            tail->next = &op;
+        }
+        else {
+            head = &op;
+        }
+        tail = &op;
+    }
+
+    /**
+     * @brief Removes the operation from the front of the queue.
+     *
+     * @return The removed operation.
+     */
+    Op& pop() noexcept
+    {
+        Op& op = *head;
+        head = static_cast<Op*>(op.next);
+        if (head == nullptr) {
+            tail = nullptr;
+        }
+
+        return op;
+    }
+};
+
+/**
+ * @brief Returns the number of exceptions being thrown on the current thread, to know if a destructor may throw.
+ *
+ * @return 0 if no exception is being thrown (before C++17, 1 if at least one is).
+ */
+inline int uncaught_exception_count() noexcept
+{
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+    return std::uncaught_exceptions();
+#else
+    return std::uncaught_exception() ? 1 : 0;
+#endif
+}
+
+/**
+ * @brief Operations completed while a channel was locked, to be completed when the lock is released.
+ *
+ * @details Create it before locking the channel: the destructor calls complete() for each operation. If some of them
+ * throw, all are still completed, then the first exception is rethrown, unless the destructor runs because of another
+ * exception.
+ */
+class async_completion {
+   public:
+    async_completion() = default;
+
+    /**
+     * @brief Adds an operation to complete.
+     *
+     * @param op The completed operation.
+     */
+    void add(async_op& op) noexcept
+    {
+        op.next = ops_;
+        ops_ = &op;
+    }
+
+    async_completion(const async_completion&) = delete;
+    async_completion& operator=(const async_completion&) = delete;
+
+    /**
+     * @brief Completes the operations.
+     */
+    ~async_completion() noexcept(false)
+    {
+        std::exception_ptr error{};
+        while (ops_ != nullptr) {
+            async_op* const op = ops_;
+            ops_ = op->next;
+            try {
+                op->complete();
+            }
+            catch (...) {
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        }
+
+        if (error && uncaught_exception_count() == uncaught_) {
+            std::rethrow_exception(error);
+        }
+    }
+
+   private:
+    async_op* ops_{};
+    int uncaught_{uncaught_exception_count()};
+};
+
+/**
+ * @brief Gives the asynchronous operations access to the channel internals.
+ */
+struct async_access {
+    /**
+     * @brief Reads an element if possible, otherwise queues the operation on the channel.
+     *
+     * @param chan The channel to read from.
+     * @param op The read operation.
+     * @return true If the operation completed right away (complete() is not called).
+     * @return false If the operation was queued.
+     */
+    template <typename Channel, typename T>
+    static bool start_read(Channel& chan, async_read_op<T>& op)
+    {
+        return chan.start_async_read(op);
+    }
+
+    /**
+     * @brief Writes an element if possible, otherwise queues the operation on the channel.
+     *
+     * @param chan The channel to write to.
+     * @param op The write operation.
+     * @return true If the operation completed right away (complete() is not called).
+     * @return false If the operation was queued.
+     */
+    template <typename Channel, typename T>
+    static bool start_write(Channel& chan, async_write_op<T>& op)
+    {
+        return chan.start_async_write(op);
+    }
+};
+
+/**
+ * @brief Runs a completion handler on the thread completing the operation.
+ */
+struct inline_dispatch {
+    /**
+     * @brief Runs the function.
+     *
+     * @param fn The function to run.
+     */
+    template <typename Function>
+    void operator()(Function&& fn) const
+    {
+        std::forward<Function>(fn)();
+    }
+};
+
+/**
+ * @brief Runs a completion handler by posting it to an executor.
+ *
+ * @tparam Executor Type with a **post** function taking a callable without arguments (eg: msd::executor).
+ */
+template <typename Executor>
+struct executor_dispatch {
+    /**
+     * @brief The executor, which must outlive the operation.
+     */
+    Executor* executor;
+
+    /**
+     * @brief Posts the function to the executor.
+     *
+     * @param fn The function to run.
+     */
+    template <typename Function>
+    void operator()(Function&& fn) const
+    {
+        executor->post(std::forward<Function>(fn));
+    }
+};
+
+/**
+ * @brief Read owning its element and completion handler, deleted after the handler is called.
+ *
+ * @tparam T The type of the elements.
+ * @tparam Handler Callable with a **channel_status** and a **T&&**.
+ * @tparam Dispatch How the handler is run (see detail::inline_dispatch, detail::executor_dispatch).
+ */
+template <typename T, typename Handler, typename Dispatch>
+class read_callback final : public async_read_op<T> {
+   public:
+    /**
+     * @brief Creates the operation.
+     *
+     * @param handler The completion handler.
+     * @param dispatch How the handler is run.
+     */
+    template <typename H>
+    read_callback(H&& handler, const Dispatch& dispatch) : handler_{std::forward<H>(handler)}, dispatch_{dispatch}
+    {
+        this->out = &value_;
+    }
+
+    /**
+     * @brief Runs the handler, then deletes the operation.
+     *
+     * @details If the handler cannot be dispatched, the operation is deleted without calling it and the exception
+     * is rethrown.
+     */
+    void complete() override
+    {
+        read_callback* const self = this;
+        try {
+            dispatch_([self]() noexcept {
+                const std::unique_ptr<read_callback> owner{self};
+                owner->handler_(owner->status, std::move(owner->value_));
+            });
+        }
+        catch (...) {
+            delete self;
+            throw;
+        }
+    }
+
+   private:
+    Handler handler_;
+    Dispatch dispatch_;
+    T value_{};
+};
+
+/**
+ * @brief Write owning its element and completion handler, deleted after the handler is called.
+ *
+ * @tparam T The type of the elements.
+ * @tparam Handler Callable with a **channel_status**.
+ * @tparam Dispatch How the handler is run (see detail::inline_dispatch, detail::executor_dispatch).
+ */
+template <typename T, typename Handler, typename Dispatch>
+class write_callback final : public async_write_op<T> {
+   public:
+    /**
+     * @brief Creates the operation.
+     *
+     * @param value The element to write.
+     * @param handler The completion handler.
+     * @param dispatch How the handler is run.
+     */
+    template <typename H>
+    write_callback(T value, H&& handler, const Dispatch& dispatch)
+        : handler_{std::forward<H>(handler)}, dispatch_{dispatch}, value_{std::move(value)}
+    {
+        this->in = &value_;
+    }
+
+    /**
+     * @brief Runs the handler, then deletes the operation.
+     *
+     * @details If the handler cannot be dispatched, the operation is deleted without calling it and the exception
+     * is rethrown.
+     */
+    void complete() override
+    {
+        write_callback* const self = this;
+        try {
+            dispatch_([self]() noexcept {
+                const std::unique_ptr<write_callback> owner{self};
+                owner->handler_(owner->status);
+            });
+        }
+        catch (...) {
+            delete self;
+            throw;
+        }
+    }
+
+   private:
+    Handler handler_;
+    Dispatch dispatch_;
+    T value_;
+};
+
+/**
+ * @brief Starts a read calling a handler when it completes, right away if an element is available.
+ *
+ * @param chan The channel to read from.
+ * @param handler Callable with a **channel_status** and a **T&&**.
+ * @param dispatch How the handler is run.
+ */
+template <typename Channel, typename Handler, typename Dispatch>
+void read_with_callback(Channel& chan, Handler&& handler, const Dispatch& dispatch)
+{
+    using op_type = read_callback<typename Channel::value_type, typename std::decay<Handler>::type, Dispatch>;
+
+    std::unique_ptr<op_type> op{new op_type{std::forward<Handler>(handler), dispatch}};
+    const bool completed = async_access::start_read(chan, *op);
+
+    // Once queued, the operation belongs to the channel until it completes.
+    op_type* const started = op.release();
+    if (completed) {
+        started->complete();
+    }
+}
+
+/**
+ * @brief Starts a write calling a handler when it completes, right away if there is space.
+ *
+ * @param chan The channel to write to.
+ * @param value The element to write.
+ * @param handler Callable with a **channel_status**.
+ * @param dispatch How the handler is run.
+ */
+template <typename Channel, typename Handler, typename Dispatch>
+void write_with_callback(Channel& chan, typename Channel::value_type value, Handler&& handler,
+                         const Dispatch& dispatch)
+{
+    using op_type = write_callback<typename Channel::value_type, typename std::decay<Handler>::type, Dispatch>;
+
+    std::unique_ptr<op_type> op{new op_type{std::move(value), std::forward<Handler>(handler), dispatch}};
+    const bool completed = async_access::start_write(chan, *op);
+
+    // Once queued, the operation belongs to the channel until it completes.
+    op_type* const started = op.release();
+    if (completed) {
+        started->complete();
+    }
+}
+
+}  // namespace detail
+
+#ifdef MSD_CHANNEL_HAS_COROUTINES
+
+namespace detail {
+
+/**
+ * @brief Resumes a coroutine inline or by posting it to an executor.
+ */
+class coroutine_resumer {
+   public:
+    /**
+     * @brief Makes the coroutine resume on an executor.
+     *
+     * @tparam Executor Type with a **post** function taking a callable without arguments (eg: msd::executor).
+     * @param executor The executor, which must outlive the operation.
+     */
+    template <typename Executor>
+    void set_executor(Executor& executor) noexcept
+    {
+        executor_ = &executor;
+        post_ = [](void* exec, std::coroutine_handle<> handle) {
+            static_cast<Executor*>(exec)->post([handle]() { handle.resume(); });
+        };
+    }
+
+    /**
+     * @brief Resumes the coroutine, on the executor if one was set, otherwise on the current thread.
+     *
+     * @param handle The coroutine to resume.
+     * @throws Whatever posting to the executor throws; the coroutine is not resumed then.
+     */
+    void resume(std::coroutine_handle<> handle)
+    {
+        if (post_ != nullptr) {
+            post_(executor_, handle);
+        }
+        else {
+            handle.resume();
+        }
+    }
+
+   private:
+    void* executor_{};
+    void (*post_)(void*, std::coroutine_handle<>){};
+};
+
+}  // namespace detail
+
+/**
+ * @brief Awaitable reading an element from a channel, suspending the coroutine until there is one.
+ *
+ * @details Returned by msd::channel::async_read(). `co_await` gives a **std::optional** with the element, or empty
+ * if the channel is closed and drained. The coroutine resumes on the thread that wrote the element, or on the
+ * executor given to on().
+ *
+ * @tparam Channel The type of the channel.
+ */
+template <typename Channel>
+class read_awaiter : private detail::async_read_op<typename Channel::value_type> {
+   public:
+    /**
+     * @brief Creates the awaitable for a channel.
+     *
+     * @param chan The channel to read from.
+     */
+    explicit read_awaiter(Channel& chan) : chan_{&chan} {}
+
+    /**
+     * @brief Makes the coroutine resume on an executor instead of the writer's thread.
+     *
+     * @tparam Executor Type with a **post** function taking a callable without arguments (eg: msd::executor).
+     * @param executor The executor, which must outlive the awaitable.
+     * @return The awaitable.
+     */
+    template <typename Executor>
+    read_awaiter on(Executor& executor) &&
+    {
+        resumer_.set_executor(executor);
+        return std::move(*this);
+    }
+
+    /**
+     * @brief Always suspends, the element is read in await_suspend().
+     *
+     * @return false
+     */
+    bool await_ready() const noexcept { return false; }
+
+    /**
+     * @brief Reads an element, or queues the coroutine as a reader if there is none.
+     *
+     * @param handle The awaiting coroutine.
+     * @return false If the element was read right away (the coroutine is not suspended).
+     */
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+        handle_ = handle;
+        this->out = &value_;
+        return !detail::async_access::start_read(*chan_, *this);
+    }
+
+    /**
+     * @brief Returns the element read.
+     *
+     * @return The element, or empty if the channel is closed and drained.
+     */
+    std::optional<typename Channel::value_type> await_resume()
+    {
+        if (this->status != channel_status::kOk) {
+            return std::nullopt;
+        }
+
+        return std::optional<typename Channel::value_type>{std::move(value_)};
+    }
+
+   private:
+    Channel* chan_;
+    typename Channel::value_type value_{};
+    std::coroutine_handle<> handle_{};
+    detail::coroutine_resumer resumer_{};
+
+    void complete() override { resumer_.resume(handle_); }
+};
+
+/**
+ * @brief Awaitable writing an element to a channel, suspending the coroutine until there is space.
+ *
+ * @details Returned by msd::channel::async_write(). `co_await` gives true if the element was written, or false if
+ * the channel is closed. The coroutine resumes on the thread that made space, or on the executor given to on().
+ *
+ * @tparam Channel The type of the channel.
+ */
+template <typename Channel>
+class write_awaiter : private detail::async_write_op<typename Channel::value_type> {
+   public:
+    /**
+     * @brief Creates the awaitable for a channel.
+     *
+     * @param chan The channel to write to.
+     * @param value The element to write.
+     */
+    write_awaiter(Channel& chan, typename Channel::value_type value) : chan_{&chan}, value_{std::move(value)} {}
+
+    /**
+     * @brief Makes the coroutine resume on an executor instead of the reader's thread.
+     *
+     * @tparam Executor Type with a **post** function taking a callable without arguments (eg: msd::executor).
+     * @param executor The executor, which must outlive the awaitable.
+     * @return The awaitable.
+     */
+    template <typename Executor>
+    write_awaiter on(Executor& executor) &&
+    {
+        resumer_.set_executor(executor);
+        return std::move(*this);
+    }
+
+    /**
+     * @brief Always suspends, the element is written in await_suspend().
+     *
+     * @return false
+     */
+    bool await_ready() const noexcept { return false; }
+
+    /**
+     * @brief Writes the element, or queues the coroutine as a writer if the channel is full.
+     *
+     * @param handle The awaiting coroutine.
+     * @return false If the element was written right away (the coroutine is not suspended).
+     */
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+        handle_ = handle;
+        this->in = &value_;
+        return !detail::async_access::start_write(*chan_, *this);
+    }
+
+    /**
+     * @brief Tells if the element was written.
+     *
+     * @return true If the element was written.
+     * @return false If the channel is closed.
+     */
+    bool await_resume() const noexcept { return this->status == channel_status::kOk; }
+
+   private:
+    Channel* chan_;
+    typename Channel::value_type value_;
+    std::coroutine_handle<> handle_{};
+    detail::coroutine_resumer resumer_{};
+
+    void complete() override { resumer_.resume(handle_); }
+};
+
+/**
+ * @brief Asynchronous equivalent of msd::blocking_iterator, reading a channel from a coroutine until it is drained.
+ *
+ * @details Iterating awaits each element:
+ * `for (auto it = co_await range.begin(); it != range.end(); co_await ++it) { use(*it); }`
+ *
+ * @tparam Channel The type of the channel.
+ */
+template <typename Channel>
+class async_range {
+   public:
+    /**
+     * @brief The type of the elements.
+     */
+    using value_type = typename Channel::value_type;
+
+    /**
+     * @brief Iterator over the elements read by the range.
+     */
+    class iterator {
+       public:
+        /**
+         * @brief Returns the latest element read.
+         *
+         * @return A reference to the element.
+         */
+        value_type& operator*() const noexcept { return range_->value_; }
+
+        /**
+         * @brief Reads the next element.
+         *
+         * @return Awaitable giving this iterator, equal to end() if the channel is drained.
+         */
+        auto operator++() { return advance_awaiter{*range_}; }
+
+        /**
+         * @brief Checks if both iterators are at the end of the channel, or neither is.
+         *
+         * @param other Iterator to compare with.
+         * @return true If both are at the end, or neither is.
+         */
+        bool operator==(const iterator& other) const noexcept { return at_end() == other.at_end(); }
+
+       private:
+        friend class async_range;
+
+        async_range* range_;
+        bool end_;
+
+        iterator(async_range& range, const bool end) noexcept : range_{&range}, end_{end} {}
+
+        bool at_end() const noexcept { return end_ || range_->done_; }
+    };
+
+    /**
+     * @brief Creates a range over a channel.
+     *
+     * @param chan The channel to read.
+     */
+    explicit async_range(Channel& chan) : chan_{&chan} {}
+
+    /**
+     * @brief Reads the first element.
+     *
+     * @return Awaitable giving an iterator, equal to end() if the channel is drained.
+     */
+    auto begin() { return advance_awaiter{*this}; }
+
+    /**
+     * @brief Returns the end of the range.
+     *
+     * @return An iterator representing the end condition.
+     */
+    iterator end() noexcept { return iterator{*this, true}; }
+
+    /**
+     * @brief Makes the coroutine resume on an executor instead of the writer's thread.
+     *
+     * @tparam Executor Type with a **post** function taking a callable without arguments (eg: msd::executor).
+     * @param executor The executor, which must outlive the range.
+     */
+    template <typename Executor>
+    void on(Executor& executor) noexcept
+    {
+        resumer_.set_executor(executor);
+    }
+
+   private:
+    class advance_awaiter : private detail::async_read_op<value_type> {
+       public:
+        explicit advance_awaiter(async_range& range) noexcept : range_{&range} {}
+
+        bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(std::coroutine_handle<> handle)
+        {
+            handle_ = handle;
+            this->out = &range_->value_;
+            return !detail::async_access::start_read(*range_->chan_, *this);
+        }
+
+        iterator await_resume() noexcept
+        {
+            range_->done_ = this->status != channel_status::kOk;
+            return iterator{*range_, false};
+        }
+
+       private:
+        async_range* range_;
+        std::coroutine_handle<> handle_{};
+
+        void complete() noexcept override { range_->resumer_.resume(handle_); }
+    };
+
+    Channel* chan_;
+    value_type value_{};
+    bool done_{};
+    detail::coroutine_resumer resumer_{};
+};
+
+#endif
+
+}  // namespace msd
+
+#endif  // MSD_CHANNEL_ASYNC_HPP_
@@ -3,6 +3,9 @@
 #ifndef MSD_CHANNEL_BLOCKING_ITERATOR_HPP_
 #define MSD_CHANNEL_BLOCKING_ITERATOR_HPP_
 
+#include "status.hpp"
+
+#include <chrono>
 #include <cstddef>
 #include <iterator>
 
@@ -93,6 +96,155 @@ class blocking_iterator {
     bool is_end_{false};
 };
 
+/**
+ * @brief An iterator like msd::blocking_iterator which stops waiting for elements at a deadline.
+ *
+ * @details Used to implement channel range-based for loop bounded in time (see msd::until).
+ *
+ * @tparam Channel Type of channel being iterated.
+ * @tparam Clock The clock of the deadline.
+ * @tparam Duration The duration type of the deadline.
+ */
+template <typename Channel, typename Clock, typename Duration>
+class deadline_iterator {
+   public:
+    /**
+     * @brief The type of the elements stored in the channel.
+     */
+    using value_type = typename Channel::value_type;
+
+    /**
+     * @brief Constant reference to the type of the elements stored in the channel.
+     */
+    using reference = const typename Channel::value_type&;
+
+    /**
+     * @brief Supporting single-pass reading of elements.
+     */
+    using iterator_category = std::input_iterator_tag;
+
+    /**
+     * @brief Signed integral type for iterator difference.
+     */
+    using difference_type = std::ptrdiff_t;
+
+    /**
+     * @brief Pointer type to the value_type.
+     */
+    using pointer = const value_type*;
+
+    /**
+     * @brief Constructs a deadline iterator from a channel reference.
+     *
+     * @param chan Reference to the channel this iterator will iterate over.
+     * @param deadline Point in time after which to stop waiting for elements.
+     * @param is_end If true, the iterator is in an end state (no elements to read).
+     */
+    deadline_iterator(Channel& chan, const std::chrono::time_point<Clock, Duration>& deadline, bool is_end = false)
+        : chan_{&chan}, deadline_{deadline}, is_end_{is_end}
+    {
+        if (!is_end_) {
+            ++*this;
+        }
+    }
+
+    /**
+     * @brief Retrieves the next element from the channel, waiting until the deadline.
+     *
+     * @return The iterator itself.
+     */
+    deadline_iterator& operator++()
+    {
+        if (chan_->read_until(value_, deadline_) != channel_status::kOk) {
+            is_end_ = true;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Returns the latest element retrieved from the channel.
+     *
+     * @return A const reference to the element.
+     */
+    reference operator*() { return value_; }
+
+    /**
+     * @brief Makes iteration continue until the channel is closed and empty, or the deadline passed.
+     *
+     * @param other Another deadline_iterator to compare with.
+     * @return true If an element was read before the deadline (continue iterating).
+     * @return false If the channel is drained or the deadline passed (stop iterating).
+     */
+    bool operator!=(const deadline_iterator& other) { return is_end_ != other.is_end_; }
+
+   private:
+    Channel* chan_;
+    std::chrono::time_point<Clock, Duration> deadline_;
+    value_type value_{};
+    bool is_end_{false};
+};
+
+/**
+ * @brief A range over the elements read from a channel until a deadline.
+ *
+ * @tparam Channel Type of channel being iterated.
+ * @tparam Clock The clock of the deadline.
+ * @tparam Duration The duration type of the deadline.
+ */
+template <typename Channel, typename Clock, typename Duration>
+class deadline_range {
+   public:
+    /**
+     * @brief The iterator type used to traverse the channel.
+     */
+    using iterator = deadline_iterator<Channel, Clock, Duration>;
+
+    /**
+     * @brief Constructs the range.
+     *
+     * @param chan Reference to the channel to iterate over.
+     * @param deadline Point in time after which to stop waiting for elements.
+     */
+    deadline_range(Channel& chan, const std::chrono::time_point<Clock, Duration>& deadline)
+        : chan_{&chan}, deadline_{deadline}
+    {
+    }
+
+    /**
+     * @brief Returns an iterator to the beginning of the range.
+     *
+     * @return A deadline iterator pointing to the first element read from the channel.
+     */
+    iterator begin() { return iterator{*chan_, deadline_}; }
+
+    /**
+     * @brief Returns an iterator representing the end of the range.
+     *
+     * @return A deadline iterator representing the end condition.
+     */
+    iterator end() { return iterator{*chan_, deadline_, true}; }
+
+   private:
+    Channel* chan_;
+    std::chrono::time_point<Clock, Duration> deadline_;
+};
+
+/**
+ * @brief Creates a range reading elements from a channel until it's drained or the deadline passes.
+ *
+ * @tparam Channel Type of channel being iterated.
+ * @tparam Clock The clock of the deadline.
+ * @tparam Duration The duration type of the deadline.
+ * @param chan Reference to the channel to iterate over.
+ * @param deadline Point in time after which to stop waiting for elements.
+ * @return A range usable in range-based for loops and standard algorithms.
+ */
+template <typename Channel, typename Clock, typename Duration>
+deadline_range<Channel, Clock, Duration> until(Channel& chan, const std::chrono::time_point<Clock, Duration>& deadline)
+{
+    return deadline_range<Channel, Clock, Duration>{chan, deadline};
+}
+
 /**
  * @brief An output iterator pushes elements into a channel. Blocking until the channel is not full.
  *
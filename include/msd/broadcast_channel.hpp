@@ -0,0 +1,705 @@
+// Copyright (C) 2020-2025 Andrei Avram
+
+#ifndef MSD_CHANNEL_BROADCAST_CHANNEL_HPP_
+#define MSD_CHANNEL_BROADCAST_CHANNEL_HPP_
+
+#include "blocking_iterator.hpp"
+#include "channel.hpp"
+#include "nodiscard.hpp"
+#include "status.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/** @file */
+
+namespace msd {
+
+/**
+ * @brief What an msd::broadcast_channel does when a write finds the ring full.
+ */
+enum class broadcast_overflow {
+    /**
+     * @brief The writer waits until the slowest subscriber reads (the slowest subscriber sets the pace).
+     */
+    kBlock,
+
+    /**
+     * @brief The slowest subscribers are dropped, so writers never wait. A dropped subscriber cannot read anymore.
+     */
+    kDropSlowest,
+};
+
+namespace detail {
+
+/**
+ * @brief Read position of a broadcast subscriber, linked in the channel's list of subscribers.
+ */
+struct broadcast_cursor {
+    /**
+     * @brief Sequence number of the next element to read.
+     */
+    std::uint64_t position{};
+
+    /**
+     * @brief Set when the subscriber was dropped for being too slow.
+     */
+    bool dropped{};
+
+    /**
+     * @brief Previous subscriber.
+     */
+    broadcast_cursor* prev{};
+
+    /**
+     * @brief Next subscriber.
+     */
+    broadcast_cursor* next{};
+};
+
+}  // namespace detail
+
+template <typename T>
+class broadcast_channel;
+
+/**
+ * @brief Reading end of an msd::broadcast_channel: sees every element written after it subscribed, in order.
+ *
+ * - Movable, not copyable. Unsubscribes when destroyed.
+ * - Must not outlive its channel.
+ * - Includes a blocking input iterator.
+ *
+ * @tparam T The type of the elements.
+ */
+template <typename T>
+class broadcast_subscription {
+   public:
+    /**
+     * @brief The type of elements read.
+     */
+    using value_type = T;
+
+    /**
+     * @brief The iterator type used to traverse the subscription.
+     */
+    using iterator = blocking_iterator<broadcast_subscription<T>>;
+
+    /**
+     * @brief The type used to represent sizes and counts.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Reads the next element.
+     *
+     * @param sub Subscription to read from.
+     * @param out Where to write read value.
+     * @return Instance of subscription.
+     */
+    template <typename Type>
+    friend broadcast_subscription<Type>& operator>>(broadcast_subscription<Type>& sub, Type& out);
+
+    /**
+     * @brief Copies the next element to the output, blocking until one is written.
+     *
+     * @param out Reference to the variable where the element will be copied.
+     * @return true If an element was read.
+     * @return false If the channel is closed and all elements were read, or the subscriber was dropped.
+     */
+    bool read(T& out)
+    {
+        return chan_->take(*cursor_, copy_to{out}, chan_->wait_forever(), channel_status::kEmpty) ==
+               channel_status::kOk;
+    }
+
+    /**
+     * @brief Copies the next element to the output, without waiting.
+     *
+     * @param out Reference to the variable where the element will be copied.
+     * @return channel_status::kOk If an element was read.
+     * @return channel_status::kEmpty If there is no element to read.
+     * @return channel_status::kClosed If the channel is closed and all elements were read, or the subscriber was
+     * dropped.
+     */
+    channel_status try_read(T& out)
+    {
+        return chan_->take(*cursor_, copy_to{out}, chan_->no_wait(), channel_status::kEmpty);
+    }
+
+    /**
+     * @brief Copies the next element to the output, waiting for one until a deadline.
+     *
+     * @tparam Clock The clock of the deadline.
+     * @tparam Duration The duration type of the deadline.
+     * @param out Reference to the variable where the element will be copied.
+     * @param deadline Point in time after which to give up waiting.
+     * @return channel_status::kOk If an element was read.
+     * @return channel_status::kTimeout If no element was written until the deadline.
+     * @return channel_status::kClosed If the channel is closed and all elements were read, or the subscriber was
+     * dropped.
+     */
+    template <typename Clock, typename Duration>
+    channel_status read_until(T& out, const std::chrono::time_point<Clock, Duration>& deadline)
+    {
+        return chan_->take(*cursor_, copy_to{out}, chan_->wait_until(deadline), channel_status::kTimeout);
+    }
+
+    /**
+     * @brief Copies the next element to the output, waiting for one at most a given duration.
+     *
+     * @tparam Rep The arithmetic type of the duration.
+     * @tparam Period The period of the duration.
+     * @param out Reference to the variable where the element will be copied.
+     * @param timeout Maximum duration to wait for.
+     * @return channel_status::kOk If an element was read.
+     * @return channel_status::kTimeout If no element was written for the whole duration.
+     * @return channel_status::kClosed If the channel is closed and all elements were read, or the subscriber was
+     * dropped.
+     */
+    template <typename Rep, typename Period>
+    channel_status read_for(T& out, const std::chrono::duration<Rep, Period>& timeout)
+    {
+        return read_until(out, std::chrono::steady_clock::now() + timeout);
+    }
+
+    /**
+     * @brief Passes the next element to a function without copying it, blocking until one is written.
+     *
+     * @details The element is shared by all subscribers, so the function gets it as const. It runs with the channel
+     * locked, so it should be short; if it throws, the element is not marked as read.
+     *
+     * @tparam Function Callable with a **const T&**.
+     * @param fn Function to process the element in place.
+     * @return true If an element was consumed.
+     * @return false If the channel is closed and all elements were read, or the subscriber was dropped.
+     */
+    template <typename Function>
+    bool consume(Function&& fn)
+    {
+        return chan_->take(*cursor_, fn, chan_->wait_forever(), channel_status::kEmpty) == channel_status::kOk;
+    }
+
+    /**
+     * @brief Returns the number of elements written but not read yet by this subscriber.
+     *
+     * @return Number of unread elements.
+     */
+    NODISCARD size_type size() const { return chan_->unread(*cursor_); }
+
+    /**
+     * @brief Checks if the subscriber was dropped for being too slow (see msd::broadcast_overflow::kDropSlowest).
+     *
+     * @return true If the subscriber was dropped.
+     * @return false Otherwise.
+     */
+    NODISCARD bool dropped() const { return chan_->dropped(*cursor_); }
+
+    /**
+     * @brief Checks if nothing can be read anymore: the channel is closed and all elements were read, or the
+     * subscriber was dropped.
+     *
+     * @return true If nothing can be read anymore.
+     * @return false Otherwise.
+     */
+    NODISCARD bool drained() const { return chan_->drained(*cursor_); }
+
+    /**
+     * @brief Returns an iterator to the beginning of the subscription.
+     *
+     * @return A blocking iterator pointing to the start of the subscription.
+     */
+    iterator begin() noexcept { return blocking_iterator<broadcast_subscription<T>>{*this}; }
+
+    /**
+     * @brief Returns an iterator representing the end of the subscription.
+     *
+     * @return A blocking iterator representing the end condition.
+     */
+    iterator end() noexcept { return blocking_iterator<broadcast_subscription<T>>{*this, true}; }
+
+    /**
+     * @brief Takes over another subscription.
+     *
+     * @param other Subscription to take over, which cannot be used anymore.
+     */
+    broadcast_subscription(broadcast_subscription&& other) noexcept
+        : chan_{other.chan_}, cursor_{std::move(other.cursor_)}
+    {
+    }
+
+    /**
+     * @brief Unsubscribes, then takes over another subscription.
+     *
+     * @param other Subscription to take over, which cannot be used anymore.
+     * @return This subscription.
+     */
+    broadcast_subscription& operator=(broadcast_subscription&& other) noexcept
+    {
+        if (this != &other) {
+            unsubscribe();
+            chan_ = other.chan_;
+            cursor_ = std::move(other.cursor_);
+        }
+
+        return *this;
+    }
+
+    broadcast_subscription(const broadcast_subscription&) = delete;
+    broadcast_subscription& operator=(const broadcast_subscription&) = delete;
+
+    /**
+     * @brief Unsubscribes, so the channel does not keep elements for this subscriber anymore.
+     */
+    ~broadcast_subscription() { unsubscribe(); }
+
+   private:
+    friend class broadcast_channel<T>;
+
+    struct copy_to {
+        T& out;
+
+        void operator()(const T& value) { out = value; }
+    };
+
+    broadcast_channel<T>* chan_;
+    std::unique_ptr<detail::broadcast_cursor> cursor_;
+
+    broadcast_subscription(broadcast_channel<T>& chan, std::unique_ptr<detail::broadcast_cursor> cursor) noexcept
+        : chan_{&chan}, cursor_{std::move(cursor)}
+    {
+    }
+
+    void unsubscribe() noexcept
+    {
+        if (cursor_) {
+            chan_->unsubscribe(*cursor_);
+            cursor_.reset();
+        }
+    }
+};
+
+/**
+ * @brief Channel where every subscriber sees every element, stored once in a shared ring.
+ *
+ * - Each element is written once into a ring of **capacity** slots and stays there until all subscribers read it.
+ * Subscribers copy it (read) or process it in place (consume), without a copy per subscriber in the channel.
+ * - A subscriber sees the elements written after it subscribed.
+ * - When the ring is full, writers wait for the slowest subscriber or drop it (see msd::broadcast_overflow).
+ * - Elements written while there are no subscribers are discarded.
+ * - Slots are reused by assignment: a read element stays in its slot until the slot is written again.
+ * - Not movable, not copyable.
+ *
+ * @tparam T The type of the elements (copy assignable and default constructible).
+ */
+template <typename T>
+class broadcast_channel {
+   public:
+    static_assert(is_supported_type<T>::value, "Type T does not meet all requirements.");
+    static_assert(std::is_default_constructible<T>::value, "Type T must be default constructible.");
+    static_assert(std::is_copy_assignable<T>::value, "Type T must be copy assignable.");
+
+    /**
+     * @brief The type of elements written to the channel.
+     */
+    using value_type = T;
+
+    /**
+     * @brief The type used to represent sizes and counts.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Creates a channel with a ring of a given capacity.
+     *
+     * @param capacity Number of elements the slowest subscriber can fall behind the writers (at least one).
+     * @param overflow What writers do when the ring is full.
+     */
+    explicit broadcast_channel(const size_type capacity, const broadcast_overflow overflow = broadcast_overflow::kBlock)
+        : slots_(capacity > 0 ? capacity : 1), overflow_{overflow}
+    {
+    }
+
+    /**
+     * @brief Writes an element for all subscribers.
+     *
+     * @param chan Channel to write to.
+     * @param value Value to write.
+     * @return Instance of channel.
+     * @throws closed_channel if channel is closed.
+     */
+    template <typename Type>
+    friend broadcast_channel<typename std::decay<Type>::type>& operator<<(
+        broadcast_channel<typename std::decay<Type>::type>& chan, Type&& value);
+
+    /**
+     * @brief Subscribes to the elements written from now on.
+     *
+     * @return The reading end of the new subscriber.
+     */
+    broadcast_subscription<T> subscribe()
+    {
+        std::unique_ptr<detail::broadcast_cursor> cursor{new detail::broadcast_cursor{}};
+
+        std::unique_lock<std::mutex> lock{mtx_};
+        cursor->position = head_;
+        cursor->next = cursors_;
+        if (cursors_ != nullptr) {
+            cursors_->prev = cursor.get();
+        }
+        cursors_ = cursor.get();
+
+        return broadcast_subscription<T>{*this, std::move(cursor)};
+    }
+
+    /**
+     * @brief Writes an element for all subscribers, waiting for the slowest one if the ring is full.
+     *
+     * @tparam Type The type of the elements.
+     * @param value The element to write.
+     * @return true If the element was written.
+     * @return false If the channel is closed.
+     */
+    template <typename Type>
+    bool write(Type&& value)
+    {
+        return put(std::forward<Type>(value), wait_forever(), channel_status::kFull) == channel_status::kOk;
+    }
+
+    /**
+     * @brief Writes an element for all subscribers, without waiting.
+     *
+     * @tparam Type The type of the elements.
+     * @param value The element to write. Not moved from if not written.
+     * @return channel_status::kOk If the element was written.
+     * @return channel_status::kFull If the ring is full (only with msd::broadcast_overflow::kBlock).
+     * @return channel_status::kClosed If the channel is closed.
+     */
+    template <typename Type>
+    channel_status try_write(Type&& value)
+    {
+        return put(std::forward<Type>(value), no_wait(), channel_status::kFull);
+    }
+
+    /**
+     * @brief Writes an element for all subscribers, waiting for the slowest one until a deadline.
+     *
+     * @tparam Type The type of the elements.
+     * @tparam Clock The clock of the deadline.
+     * @tparam Duration The duration type of the deadline.
+     * @param value The element to write. Not moved from if not written.
+     * @param deadline Point in time after which to give up waiting.
+     * @return channel_status::kOk If the element was written.
+     * @return channel_status::kTimeout If the ring stayed full until the deadline.
+     * @return channel_status::kClosed If the channel is closed.
+     */
+    template <typename Type, typename Clock, typename Duration>
+    channel_status write_until(Type&& value, const std::chrono::time_point<Clock, Duration>& deadline)
+    {
+        return put(std::forward<Type>(value), wait_until(deadline), channel_status::kTimeout);
+    }
+
+    /**
+     * @brief Writes an element for all subscribers, waiting for the slowest one at most a given duration.
+     *
+     * @tparam Type The type of the elements.
+     * @tparam Rep The arithmetic type of the duration.
+     * @tparam Period The period of the duration.
+     * @param value The element to write. Not moved from if not written.
+     * @param timeout Maximum duration to wait for.
+     * @return channel_status::kOk If the element was written.
+     * @return channel_status::kTimeout If the ring stayed full for the whole duration.
+     * @return channel_status::kClosed If the channel is closed.
+     */
+    template <typename Type, typename Rep, typename Period>
+    channel_status write_for(Type&& value, const std::chrono::duration<Rep, Period>& timeout)
+    {
+        return write_until(std::forward<Type>(value), std::chrono::steady_clock::now() + timeout);
+    }
+
+    /**
+     * @brief Returns the number of elements not read yet by the slowest subscriber.
+     *
+     * @return Number of elements kept in the ring.
+     */
+    NODISCARD size_type size() const
+    {
+        std::unique_lock<std::mutex> lock{mtx_};
+        return static_cast<size_type>(head_ - oldest());
+    }
+
+    /**
+     * @brief Returns the number of slots of the ring.
+     *
+     * @return The capacity.
+     */
+    NODISCARD size_type capacity() const noexcept { return slots_.size(); }
+
+    /**
+     * @brief Returns the number of subscribers, including the dropped ones that still exist.
+     *
+     * @return Number of subscribers.
+     */
+    NODISCARD size_type subscribers() const
+    {
+        std::unique_lock<std::mutex> lock{mtx_};
+
+        size_type count = 0;
+        for (const detail::broadcast_cursor* cursor = cursors_; cursor != nullptr; cursor = cursor->next) {
+            ++count;
+        }
+
+        return count;
+    }
+
+    /**
+     * @brief Closes the channel: no element can be written anymore, subscribers read the ones left.
+     */
+    void close() noexcept
+    {
+        {
+            std::unique_lock<std::mutex> lock{mtx_};
+            closed_ = true;
+        }
+        read_cnd_.notify_all();
+        write_cnd_.notify_all();
+    }
+
+    /**
+     * @brief Checks if the channel has been closed.
+     *
+     * @return true If no more elements can be written.
+     * @return false Otherwise.
+     */
+    NODISCARD bool closed() const noexcept
+    {
+        std::unique_lock<std::mutex> lock{mtx_};
+        return closed_;
+    }
+
+    broadcast_channel(const broadcast_channel&) = delete;
+    broadcast_channel& operator=(const broadcast_channel&) = delete;
+    broadcast_channel(broadcast_channel&&) = delete;
+    broadcast_channel& operator=(broadcast_channel&&) = delete;
+    virtual ~broadcast_channel() = default;
+
+   private:
+    friend class broadcast_subscription<T>;
+
+    std::vector<T> slots_;
+    const broadcast_overflow overflow_;
+    std::uint64_t head_{0};
+    detail::broadcast_cursor* cursors_{};
+    bool closed_{};
+    std::size_t waiting_readers_{0};
+    std::size_t waiting_writers_{0};
+    mutable std::mutex mtx_;
+    std::condition_variable read_cnd_;
+    std::condition_variable write_cnd_;
+
+    // Waits are called with the channel locked and return false if the predicate is still not satisfied.
+    struct no_wait_t {
+        template <typename Predicate>
+        bool operator()(std::unique_lock<std::mutex>&, std::condition_variable&, Predicate pred) const
+        {
+            return pred();
+        }
+    };
+
+    struct wait_forever_t {
+        template <typename Predicate>
+        bool operator()(std::unique_lock<std::mutex>& lock, std::condition_variable& cnd, Predicate pred) const
+        {
+            cnd.wait(lock, pred);
+            return true;
+        }
+    };
+
+    template <typename Clock, typename Duration>
+    struct wait_until_t {
+        std::chrono::time_point<Clock, Duration> deadline;
+
+        template <typename Predicate>
+        bool operator()(std::unique_lock<std::mutex>& lock, std::condition_variable& cnd, Predicate pred) const
+        {
+            return cnd.wait_until(lock, deadline, pred);
+        }
+    };
+
+    static no_wait_t no_wait() noexcept { return no_wait_t{}; }
+
+    static wait_forever_t wait_forever() noexcept { return wait_forever_t{}; }
+
+    template <typename Clock, typename Duration>
+    static wait_until_t<Clock, Duration> wait_until(const std::chrono::time_point<Clock, Duration>& deadline)
+    {
+        return wait_until_t<Clock, Duration>{deadline};
+    }
+
+    // Position of the slowest subscriber that was not dropped.
+    std::uint64_t oldest() const noexcept
+    {
+        std::uint64_t position = head_;
+        for (const detail::broadcast_cursor* cursor = cursors_; cursor != nullptr; cursor = cursor->next) {
+            if (!cursor->dropped && cursor->position < position) {
+                position = cursor->position;
+            }
+        }
+
+        return position;
+    }
+
+    bool full() const noexcept { return head_ - oldest() >= slots_.size(); }
+
+    void drop_slowest() noexcept
+    {
+        while (full()) {
+            const std::uint64_t position = oldest();
+            for (detail::broadcast_cursor* cursor = cursors_; cursor != nullptr; cursor = cursor->next) {
+                if (cursor->position == position) {
+                    cursor->dropped = true;
+                }
+            }
+        }
+    }
+
+    template <typename Type, typename Wait>
+    channel_status put(Type&& value, Wait wait, const channel_status not_ready)
+    {
+        {
+            std::unique_lock<std::mutex> lock{mtx_};
+
+            if (overflow_ == broadcast_overflow::kDropSlowest) {
+                if (!closed_) {
+                    drop_slowest();
+                }
+            }
+            else {
+                ++waiting_writers_;
+                const bool ready = wait(lock, write_cnd_, [this]() { return closed_ || !full(); });
+                --waiting_writers_;
+
+                if (!ready) {
+                    return not_ready;
+                }
+            }
+
+            if (closed_) {
+                return channel_status::kClosed;
+            }
+
+            slots_[static_cast<size_type>(head_ % slots_.size())] = std::forward<Type>(value);
+            ++head_;
+
+            if (waiting_readers_ == 0) {
+                return channel_status::kOk;
+            }
+        }
+
+        read_cnd_.notify_all();
+        return channel_status::kOk;
+    }
+
+    template <typename Function, typename Wait>
+    channel_status take(detail::broadcast_cursor& cursor, Function&& fn, Wait wait, const channel_status not_ready)
+    {
+        bool notify_writers{};
+        {
+            std::unique_lock<std::mutex> lock{mtx_};
+
+            ++waiting_readers_;
+            const bool ready = wait(lock, read_cnd_, [this, &cursor]() {
+                return cursor.dropped || cursor.position != head_ || closed_;
+            });
+            --waiting_readers_;
+
+            if (!ready) {
+                return not_ready;
+            }
+            if (cursor.dropped || cursor.position == head_) {
+                return channel_status::kClosed;
+            }
+
+            fn(static_cast<const T&>(slots_[static_cast<size_type>(cursor.position % slots_.size())]));
+            ++cursor.position;
+            notify_writers = waiting_writers_ > 0;
+        }
+
+        if (notify_writers) {
+            write_cnd_.notify_all();
+        }
+
+        return channel_status::kOk;
+    }
+
+    size_type unread(const detail::broadcast_cursor& cursor) const
+    {
+        std::unique_lock<std::mutex> lock{mtx_};
+        return cursor.dropped ? 0 : static_cast<size_type>(head_ - cursor.position);
+    }
+
+    bool dropped(const detail::broadcast_cursor& cursor) const
+    {
+        std::unique_lock<std::mutex> lock{mtx_};
+        return cursor.dropped;
+    }
+
+    bool drained(const detail::broadcast_cursor& cursor) const
+    {
+        std::unique_lock<std::mutex> lock{mtx_};
+        return cursor.dropped || (closed_ && cursor.position == head_);
+    }
+
+    void unsubscribe(detail::broadcast_cursor& cursor) noexcept
+    {
+        {
+            std::unique_lock<std::mutex> lock{mtx_};
+            if (cursor.prev != nullptr) {
+                cursor.prev->next = cursor.next;
+            }
+            else {
+                cursors_ = cursor.next;
+            }
+            if (cursor.next != nullptr) {
+                cursor.next->prev = cursor.prev;
+            }
+        }
+
+        write_cnd_.notify_all();
+    }
+};
+
+/**
+ * @copydoc msd::broadcast_channel::operator<<
+ */
+template <typename T>
+broadcast_channel<typename std::decay<T>::type>& operator<<(broadcast_channel<typename std::decay<T>::type>& chan,
+                                                            T&& value)
+{
+    if (!chan.write(std::forward<T>(value))) {
+        throw closed_channel{"cannot write on closed channel"};
+    }
+
+    return chan;
+}
+
+/**
+ * @copydoc msd::broadcast_subscription::operator>>
+ */
+template <typename T>
+broadcast_subscription<T>& operator>>(broadcast_subscription<T>& sub, T& out)
+{
+    sub.read(out);
+
+    return sub;
+}
+
+}  // namespace msd
+
+#endif  // MSD_CHANNEL_BROADCAST_CHANNEL_HPP_
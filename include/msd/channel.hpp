@@ -3,15 +3,25 @@
 #ifndef MSD_CHANNEL_CHANNEL_HPP_
 #define MSD_CHANNEL_CHANNEL_HPP_
 
+#include "async.hpp"
 #include "blocking_iterator.hpp"
 #include "nodiscard.hpp"
+#include "parking.hpp"
+#include "statistics.hpp"
+#include "status.hpp"
 #include "storage.hpp"
+#include "wait_strategy.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <condition_variable>
 #include <cstdlib>
+#include <iterator>
+#include <limits>
 #include <mutex>
 #include <stdexcept>
 #include <type_traits>
+#include <utility>
 
 /** @file */
 
@@ -30,6 +40,10 @@ class closed_channel : public std::runtime_error {
     explicit closed_channel(const char* msg) : std::runtime_error{msg} {}
 };
 
+namespace detail {
+struct select_access;
+}  // namespace detail
+
 /**
  * @brief Default storage for msd::channel.
  *
@@ -44,11 +58,13 @@ using default_storage = queue_storage<T>;
  *
  * This trait ensures the type meets all requirements to be safely used
  * within the channel:
- * - Default constructible: must be able to create a default instance.
  * - Move constructible: must be movable to allow efficient element transfer.
  * - Move assignable: must support move assignment for storage management.
  * - Destructible: must have a valid destructor.
  *
+ * @note Some storages (eg: msd::array_storage), the lock-free channels, the iterators, and the bulk reads also require
+ * the type to be default constructible.
+ *
  * @tparam T The type to check.
  */
 template <typename T>
@@ -56,8 +72,8 @@ struct is_supported_type {
     /**
      * @brief Indicates if the type meets all channel requirements.
      */
-    static constexpr bool value = std::is_default_constructible<T>::value && std::is_move_constructible<T>::value &&
-                                  std::is_move_assignable<T>::value && std::is_destructible<T>::value;
+    static constexpr bool value =
+        std::is_move_constructible<T>::value && std::is_move_assignable<T>::value && std::is_destructible<T>::value;
 };
 
 /**
@@ -82,9 +98,14 @@ struct is_static_storage<Storage, decltype((void)Storage::capacity, void())> : s
  *
  * @tparam T The type of the elements.
  * @tparam Storage The storage type used to hold the elements. Default: msd::queue_storage.
+ * @tparam WaitStrategy What to do before parking a thread that cannot make progress (see msd::blocking_wait,
+ * msd::busy_wait, msd::backoff_wait). Default: msd::blocking_wait.
+ * @tparam Statistics What to record about the operations (see msd::no_statistics, msd::channel_statistics). Default:
+ * msd::no_statistics, which adds no size and no code.
  */
-template <typename T, typename Storage = default_storage<T>>
-class channel {
+template <typename T, typename Storage = default_storage<T>, typename WaitStrategy = blocking_wait,
+          typename Statistics = no_statistics>
+class channel : private Statistics, private detail::spin_state<detail::strategy_spins<WaitStrategy>::value> {
    public:
     static_assert(is_supported_type<T>::value, "Type T does not meet all requirements.");
 
@@ -96,7 +117,7 @@ class channel {
     /**
      * @brief The iterator type used to traverse the channel.
      */
-    using iterator = blocking_iterator<channel<T, Storage>>;
+    using iterator = blocking_iterator<channel<T, Storage, WaitStrategy, Statistics>>;
 
     /**
      * @brief The type used to represent sizes and counts.
@@ -131,6 +152,18 @@ class channel {
     {
     }
 
+    /**
+     * @brief Creates a channel whose **Storage** allocates with a given allocator (if it has an **allocator_type**).
+     *
+     * @param capacity Number of elements the channel can store before blocking (0 means unbuffered).
+     * @param allocator Allocator passed to the storage.
+     */
+    template <typename S = Storage, typename std::enable_if<!is_static_storage<S>::value, int>::type = 0>
+    channel(const size_type capacity, const typename S::allocator_type& allocator)
+        : storage_{capacity, allocator}, capacity_{capacity}
+    {
+    }
+
     /**
      * @brief Pushes an element into the channel.
      *
@@ -139,9 +172,9 @@ class channel {
      * @return Instance of channel.
      * @throws closed_channel if channel is closed.
      */
-    template <typename Type, typename Store>
-    friend channel<typename std::decay<Type>::type, Store>& operator<<(
-        channel<typename std::decay<Type>::type, Store>& chan, Type&& value);
+    template <typename Type, typename Store, typename Wait, typename Stats>
+    friend channel<typename std::decay<Type>::type, Store, Wait, Stats>& operator<<(
+        channel<typename std::decay<Type>::type, Store, Wait, Stats>& chan, Type&& value);
 
     /**
      * @brief Pops an element from the channel.
@@ -150,8 +183,8 @@ class channel {
      * @param out Where to write read value.
      * @return Instance of channel.
      */
-    template <typename Type, typename Store>
-    friend channel<Type, Store>& operator>>(channel<Type, Store>& chan, Type& out);
+    template <typename Type, typename Store, typename Wait, typename Stats>
+    friend channel<Type, Store, Wait, Stats>& operator>>(channel<Type, Store, Wait, Stats>& chan, Type& out);
 
     /**
      * @brief Pushes an element into the channel.
@@ -164,8 +197,10 @@ class channel {
     template <typename Type>
     bool write(Type&& value)
     {
+        detail::async_completion done;
+        bool notify_reader{};
         {
-            std::unique_lock<std::mutex> lock{mtx_};
+            std::unique_lock<std::mutex> lock = lock_for_operation();
             wait_before_write(lock);
 
             if (is_closed_) {
@@ -173,13 +208,207 @@ class channel {
             }
 
             storage_.push_back(std::forward<Type>(value));
+            stats().on_write(1, storage_.size());
+            signal_waiters(done);
+            notify_reader = waiting_readers_ > 0;
+        }
+
+        if (notify_reader) {
+            read_cnd_.notify_one();
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Constructs an element in place in the channel.
+     *
+     * @details Forwards the arguments to **Storage::emplace_back**, so the element is built directly in its slot
+     * instead of being constructed by the caller and moved into the storage.
+     *
+     * @tparam Args Types of the arguments of the element's constructor.
+     * @param args The arguments of the element's constructor.
+     * @return true If an element was successfully constructed in the channel.
+     * @return false If the channel is closed.
+     */
+    template <typename... Args>
+    bool emplace(Args&&... args)
+    {
+        detail::async_completion done;
+        bool notify_reader{};
+        {
+            std::unique_lock<std::mutex> lock = lock_for_operation();
+            wait_before_write(lock);
+
+            if (is_closed_) {
+                return false;
+            }
+
+            storage_.emplace_back(std::forward<Args>(args)...);
+            stats().on_write(1, storage_.size());
+            signal_waiters(done);
+            notify_reader = waiting_readers_ > 0;
         }
 
-        cnd_.notify_one();
+        if (notify_reader) {
+            read_cnd_.notify_one();
+        }
 
         return true;
     }
 
+    /**
+     * @brief Pushes an element into the channel if there is space, without waiting.
+     *
+     * @tparam Type The type of the elements.
+     * @param value The element to be pushed into the channel. Not moved from if it is not pushed.
+     * @return channel_status::kOk If the element was pushed.
+     * @return channel_status::kFull If the channel is full.
+     * @return channel_status::kClosed If the channel is closed.
+     */
+    template <typename Type>
+    channel_status try_write(Type&& value)
+    {
+        detail::async_completion done;
+        bool notify_reader{};
+        {
+            std::unique_lock<std::mutex> lock = lock_for_operation();
+
+            if (is_closed_) {
+                return channel_status::kClosed;
+            }
+
+            if (capacity_ > 0 && storage_.size() >= capacity_) {
+                return channel_status::kFull;
+            }
+
+            storage_.push_back(std::forward<Type>(value));
+            stats().on_write(1, storage_.size());
+            signal_waiters(done);
+            notify_reader = waiting_readers_ > 0;
+        }
+
+        if (notify_reader) {
+            read_cnd_.notify_one();
+        }
+
+        return channel_status::kOk;
+    }
+
+    /**
+     * @brief Pushes an element into the channel, waiting for space until a deadline.
+     *
+     * @tparam Type The type of the elements.
+     * @tparam Clock The clock of the deadline.
+     * @tparam Duration The duration type of the deadline.
+     * @param value The element to be pushed into the channel. Not moved from if it is not pushed.
+     * @param deadline Point in time after which to give up waiting.
+     * @return channel_status::kOk If the element was pushed.
+     * @return channel_status::kTimeout If the channel was full until the deadline.
+     * @return channel_status::kClosed If the channel is closed.
+     */
+    template <typename Type, typename Clock, typename Duration>
+    channel_status write_until(Type&& value, const std::chrono::time_point<Clock, Duration>& deadline)
+    {
+        detail::async_completion done;
+        bool notify_reader{};
+        {
+            std::unique_lock<std::mutex> lock = lock_for_operation();
+
+            if (!wait_before_write(lock, deadline)) {
+                return channel_status::kTimeout;
+            }
+
+            if (is_closed_) {
+                return channel_status::kClosed;
+            }
+
+            storage_.push_back(std::forward<Type>(value));
+            stats().on_write(1, storage_.size());
+            signal_waiters(done);
+            notify_reader = waiting_readers_ > 0;
+        }
+
+        if (notify_reader) {
+            read_cnd_.notify_one();
+        }
+
+        return channel_status::kOk;
+    }
+
+    /**
+     * @brief Pushes an element into the channel, waiting for space at most a given duration.
+     *
+     * @tparam Type The type of the elements.
+     * @tparam Rep The arithmetic type of the duration.
+     * @tparam Period The period of the duration.
+     * @param value The element to be pushed into the channel. Not moved from if it is not pushed.
+     * @param timeout Maximum duration to wait for.
+     * @return channel_status::kOk If the element was pushed.
+     * @return channel_status::kTimeout If the channel was full for the whole duration.
+     * @return channel_status::kClosed If the channel is closed.
+     */
+    template <typename Type, typename Rep, typename Period>
+    channel_status write_for(Type&& value, const std::chrono::duration<Rep, Period>& timeout)
+    {
+        return write_until(std::forward<Type>(value), std::chrono::steady_clock::now() + timeout);
+    }
+
+    /**
+     * @brief Pushes a range of elements into the channel.
+     *
+     * @details Pushes as many elements as there is space for under a single lock and blocks only for the remainder.
+     * Readers are notified once for each group of pushed elements. Elements of the range are copied, use
+     * std::make_move_iterator to move them.
+     *
+     * @tparam InputIterator Type of the iterators delimiting the range.
+     * @param first Beginning of the range.
+     * @param last End of the range.
+     * @return The number of elements pushed into the channel (less than the size of the range if the channel is
+     * closed).
+     * @note Elements from other writers can be interleaved with the range when the channel is full.
+     */
+    template <typename InputIterator>
+    size_type write(InputIterator first, InputIterator last)
+    {
+        detail::async_completion done;
+        size_type count{};
+        bool notify_readers{};
+        {
+            std::unique_lock<std::mutex> lock = lock_for_operation();
+
+            while (first != last) {
+                wait_before_write(lock);
+
+                if (is_closed_) {
+                    break;
+                }
+
+                do {
+                    storage_.push_back(*first);
+                    stats().on_write(1, storage_.size());
+                    ++first;
+                    ++count;
+                } while (first != last && (capacity_ == 0 || storage_.size() < capacity_));
+
+                signal_waiters(done);
+
+                // Readers must make room before the rest of the range can be pushed.
+                if (first != last && waiting_readers_ > 0) {
+                    read_cnd_.notify_all();
+                }
+            }
+
+            notify_readers = count > 0 && waiting_readers_ > 0;
+        }
+
+        if (notify_readers) {
+            read_cnd_.notify_all();
+        }
+
+        return count;
+    }
+
     /**
      * @brief Pops an element from the channel.
      *
@@ -189,8 +418,10 @@ class channel {
      */
     bool read(T& out)
     {
+        detail::async_completion done;
+        bool notify_writer{};
         {
-            std::unique_lock<std::mutex> lock{mtx_};
+            std::unique_lock<std::mutex> lock = lock_for_operation();
             wait_before_read(lock);
 
             if (storage_.size() == 0 && is_closed_) {
@@ -198,13 +429,255 @@ class channel {
             }
 
             storage_.pop_front(out);
+            stats().on_read(1);
+            signal_waiters(done);
+            notify_writer = waiting_writers_ > 0;
         }
 
-        cnd_.notify_one();
+        if (notify_writer) {
+            write_cnd_.notify_one();
+        }
 
         return true;
     }
 
+    /**
+     * @brief Pops an element from the channel if there is one, without waiting.
+     *
+     * @param out Reference to the variable where the popped element will be stored.
+     * @return channel_status::kOk If an element was read.
+     * @return channel_status::kEmpty If the channel is empty.
+     * @return channel_status::kClosed If the channel is closed and empty.
+     */
+    channel_status try_read(T& out)
+    {
+        detail::async_completion done;
+        bool notify_writer{};
+        {
+            std::unique_lock<std::mutex> lock = lock_for_operation();
+
+            if (storage_.size() == 0) {
+                return is_closed_ ? channel_status::kClosed : channel_status::kEmpty;
+            }
+
+            storage_.pop_front(out);
+            stats().on_read(1);
+            signal_waiters(done);
+            notify_writer = waiting_writers_ > 0;
+        }
+
+        if (notify_writer) {
+            write_cnd_.notify_one();
+        }
+
+        return channel_status::kOk;
+    }
+
+    /**
+     * @brief Pops an element from the channel, waiting for one until a deadline.
+     *
+     * @tparam Clock The clock of the deadline.
+     * @tparam Duration The duration type of the deadline.
+     * @param out Reference to the variable where the popped element will be stored.
+     * @param deadline Point in time after which to give up waiting.
+     * @return channel_status::kOk If an element was read.
+     * @return channel_status::kTimeout If the channel was empty until the deadline.
+     * @return channel_status::kClosed If the channel is closed and empty.
+     */
+    template <typename Clock, typename Duration>
+    channel_status read_until(T& out, const std::chrono::time_point<Clock, Duration>& deadline)
+    {
+        detail::async_completion done;
+        bool notify_writer{};
+        {
+            std::unique_lock<std::mutex> lock = lock_for_operation();
+
+            if (!wait_before_read(lock, deadline)) {
+                return channel_status::kTimeout;
+            }
+
+            if (storage_.size() == 0 && is_closed_) {
+                return channel_status::kClosed;
+            }
+
+            storage_.pop_front(out);
+            stats().on_read(1);
+            signal_waiters(done);
+            notify_writer = waiting_writers_ > 0;
+        }
+
+        if (notify_writer) {
+            write_cnd_.notify_one();
+        }
+
+        return channel_status::kOk;
+    }
+
+    /**
+     * @brief Pops an element from the channel, waiting for one at most a given duration.
+     *
+     * @tparam Rep The arithmetic type of the duration.
+     * @tparam Period The period of the duration.
+     * @param out Reference to the variable where the popped element will be stored.
+     * @param timeout Maximum duration to wait for.
+     * @return channel_status::kOk If an element was read.
+     * @return channel_status::kTimeout If the channel was empty for the whole duration.
+     * @return channel_status::kClosed If the channel is closed and empty.
+     */
+    template <typename Rep, typename Period>
+    channel_status read_for(T& out, const std::chrono::duration<Rep, Period>& timeout)
+    {
+        return read_until(out, std::chrono::steady_clock::now() + timeout);
+    }
+
+    /**
+     * @brief Pops up to **count** elements from the channel.
+     *
+     * @details Blocks until at least one element is available, then moves out as many elements as are available (up
+     * to **count**) under a single lock. Writers are notified once for the whole group.
+     *
+     * @tparam OutputIterator Type of the iterator to move the elements to.
+     * @param out Beginning of the destination range.
+     * @param count Maximum number of elements to pop.
+     * @return The number of elements popped, 0 only if the channel is closed and empty (or if **count** is 0).
+     */
+    template <typename OutputIterator>
+    size_type read_n(OutputIterator out, const size_type count)
+    {
+        if (count == 0) {
+            return 0;
+        }
+
+        detail::async_completion done;
+        size_type read_count{};
+        bool notify_writers{};
+        {
+            std::unique_lock<std::mutex> lock = lock_for_operation();
+            wait_before_read(lock);
+
+            T value{};
+            while (read_count < count && storage_.size() > 0) {
+                storage_.pop_front(value);
+                *out = std::move(value);
+                ++out;
+                ++read_count;
+            }
+
+            if (read_count > 0) {
+                stats().on_read(read_count);
+                signal_waiters(done);
+            }
+
+            notify_writers = read_count > 0 && waiting_writers_ > 0;
+        }
+
+        if (notify_writers) {
+            write_cnd_.notify_all();
+        }
+
+        return read_count;
+    }
+
+    /**
+     * @brief Pops all available elements from the channel to the back of a container.
+     *
+     * @details Blocks until at least one element is available, like read_n().
+     *
+     * @tparam Container Type of the container, must support push_back.
+     * @param container Container to append the elements to.
+     * @return The number of elements popped, 0 only if the channel is closed and empty.
+     */
+    template <typename Container>
+    size_type drain_into(Container& container)
+    {
+        return read_n(std::back_inserter(container), std::numeric_limits<size_type>::max());
+    }
+
+    /**
+     * @brief Pops an element from the channel, passing it to a function before removing it, instead of moving it out.
+     *
+     * @details Blocks until an element is available. The function runs with the channel locked, so it should be short;
+     * if it throws, the element is not removed.
+     *
+     * @tparam Function Callable with a **T&**, requires **Storage::front** and **Storage::pop_front()**.
+     * @param fn Function to process the element in place.
+     * @return true If an element was consumed.
+     * @return false If the channel is closed and empty.
+     */
+    template <typename Function>
+    bool consume(Function&& fn)
+    {
+        detail::async_completion done;
+        bool notify_writer{};
+        {
+            std::unique_lock<std::mutex> lock = lock_for_operation();
+            wait_before_read(lock);
+
+            if (storage_.size() == 0 && is_closed_) {
+                return false;
+            }
+
+            std::forward<Function>(fn)(storage_.front());
+            storage_.pop_front();
+            stats().on_read(1);
+            signal_waiters(done);
+            notify_writer = waiting_writers_ > 0;
+        }
+
+        if (notify_writer) {
+            write_cnd_.notify_one();
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Pops up to **count** elements from the channel, passing them to a function as a contiguous range before
+     * removing them.
+     *
+     * @details Blocks until at least one element is available, like read_n(). Only the elements stored contiguously
+     * from the front are passed, so a full ring storage might need two calls to be emptied. The function runs with the
+     * channel locked, so it should be short; if it throws, no element is removed.
+     *
+     * @tparam Function Callable with a **T*** to the first element and the number of elements, requires
+     * **Storage::front_data**, **Storage::front_contiguous** and **Storage::pop_front_n** (ring storages).
+     * @param fn Function to process the elements in place.
+     * @param count Maximum number of elements to consume.
+     * @return The number of elements consumed, 0 only if the channel is closed and empty (or if **count** is 0).
+     */
+    template <typename Function>
+    size_type consume_batch(Function&& fn, const size_type count = std::numeric_limits<size_type>::max())
+    {
+        if (count == 0) {
+            return 0;
+        }
+
+        detail::async_completion done;
+        size_type consumed{};
+        bool notify_writers{};
+        {
+            std::unique_lock<std::mutex> lock = lock_for_operation();
+            wait_before_read(lock);
+
+            consumed = std::min(storage_.front_contiguous(), count);
+            if (consumed == 0) {
+                return 0;
+            }
+
+            std::forward<Function>(fn)(storage_.front_data(), consumed);
+            storage_.pop_front_n(consumed);
+            stats().on_read(consumed);
+            signal_waiters(done);
+            notify_writers = waiting_writers_ > 0;
+        }
+
+        if (notify_writers) {
+            write_cnd_.notify_all();
+        }
+
+        return consumed;
+    }
+
     /**
      * @brief Returns the current size of the channel.
      *
@@ -233,11 +706,14 @@ class channel {
      */
     void close() noexcept
     {
+        detail::async_completion done;
         {
-            std::unique_lock<std::mutex> lock{mtx_};
+            std::unique_lock<std::mutex> lock = lock_for_operation();
             is_closed_ = true;
+            signal_waiters(done);
         }
-        cnd_.notify_all();
+        read_cnd_.notify_all();
+        write_cnd_.notify_all();
     }
 
     /**
@@ -264,42 +740,426 @@ class channel {
         return storage_.size() == 0 && is_closed_;
     }
 
+    /**
+     * @brief Returns the histogram of the time elements stayed in the channel (if **Storage** has a **latency**
+     * function, eg: msd::timestamped_storage).
+     *
+     * @return The histogram, which can be read, scraped and reset without locking the channel.
+     */
+    template <typename S = Storage>
+    auto latency() noexcept -> decltype(std::declval<S&>().latency())
+    {
+        return storage_.latency();
+    }
+
+    /**
+     * @brief Returns the counters recorded by the **Statistics** policy (if it has a **snapshot_type**).
+     *
+     * @return A consistent copy of the counters.
+     */
+    template <typename S = Statistics>
+    NODISCARD typename S::snapshot_type statistics() const
+    {
+        std::unique_lock<std::mutex> lock{mtx_};
+        return Statistics::snapshot();
+    }
+
     /**
      * @brief Returns an iterator to the beginning of the channel.
      *
      * @return A blocking iterator pointing to the start of the channel.
      */
-    iterator begin() noexcept { return blocking_iterator<channel<T, Storage>>{*this}; }
+    iterator begin() noexcept { return blocking_iterator<channel<T, Storage, WaitStrategy, Statistics>>{*this}; }
 
     /**
      * @brief Returns an iterator representing the end of the channel.
      *
      * @return A blocking iterator representing the end condition.
      */
-    iterator end() noexcept { return blocking_iterator<channel<T, Storage>>{*this, true}; }
+    iterator end() noexcept { return blocking_iterator<channel<T, Storage, WaitStrategy, Statistics>>{*this, true}; }
+
+    /**
+     * @brief Pops an element without blocking, calling a handler when it is read.
+     *
+     * @details If the channel is empty, the read is queued and the handler is called on the thread whose write (or
+     * close) completes it, after the channel is unlocked; otherwise it is called right away. Lets a thread that must
+     * not block (eg: an event loop) wait on many channels.
+     *
+     * @tparam Handler Callable with a **channel_status** and a **T&&**. It must not throw.
+     * @param handler Called with channel_status::kOk and the element, or with channel_status::kClosed and a default
+     * constructed element if the channel is closed and drained.
+     * @note The channel must outlive the queued operations.
+     */
+    template <typename Handler>
+    void async_read(Handler&& handler)
+    {
+        detail::read_with_callback(*this, std::forward<Handler>(handler), detail::inline_dispatch{});
+    }
+
+    /**
+     * @brief Pops an element without blocking, posting a handler to an executor when it is read.
+     *
+     * @tparam Handler Callable with a **channel_status** and a **T&&**.
+     * @tparam Executor Type with a **post** function taking a callable without arguments (eg: msd::executor).
+     * @param handler Called with channel_status::kOk and the element, or with channel_status::kClosed and a default
+     * constructed element if the channel is closed and drained.
+     * @param executor Executor running the handler, which must outlive the operation.
+     */
+    template <typename Handler, typename Executor>
+    void async_read(Handler&& handler, Executor& executor)
+    {
+        detail::read_with_callback(*this, std::forward<Handler>(handler),
+                                   detail::executor_dispatch<Executor>{&executor});
+    }
+
+    /**
+     * @brief Pushes an element without blocking, calling a handler when it is written.
+     *
+     * @details If the channel is full, the write is queued and the handler is called on the thread whose read (or
+     * close) completes it, after the channel is unlocked; otherwise it is called right away.
+     *
+     * @tparam Handler Callable with a **channel_status**. It must not throw.
+     * @param value The element to be pushed into the channel.
+     * @param handler Called with channel_status::kOk, or with channel_status::kClosed if the channel is closed.
+     * @note The channel must outlive the queued operations.
+     */
+    template <typename Handler>
+    void async_write(T value, Handler&& handler)
+    {
+        detail::write_with_callback(*this, std::move(value), std::forward<Handler>(handler), detail::inline_dispatch{});
+    }
+
+    /**
+     * @brief Pushes an element without blocking, posting a handler to an executor when it is written.
+     *
+     * @tparam Handler Callable with a **channel_status**.
+     * @tparam Executor Type with a **post** function taking a callable without arguments (eg: msd::executor).
+     * @param value The element to be pushed into the channel.
+     * @param handler Called with channel_status::kOk, or with channel_status::kClosed if the channel is closed.
+     * @param executor Executor running the handler, which must outlive the operation.
+     */
+    template <typename Handler, typename Executor>
+    void async_write(T value, Handler&& handler, Executor& executor)
+    {
+        detail::write_with_callback(*this, std::move(value), std::forward<Handler>(handler),
+                                    detail::executor_dispatch<Executor>{&executor});
+    }
+
+#ifdef MSD_CHANNEL_HAS_COROUTINES
+    /**
+     * @brief Pops an element from a coroutine (C++20).
+     *
+     * @details `co_await chan.async_read()` gives a **std::optional** with the element, or empty if the channel is
+     * closed and drained. If the channel is empty, the coroutine is queued as a reader and resumed by the writer, on
+     * the writer's thread, or on an executor: `co_await chan.async_read().on(executor)`.
+     *
+     * @return Awaitable reading an element. The channel must outlive it.
+     */
+    read_awaiter<channel> async_read() { return read_awaiter<channel>{*this}; }
+
+    /**
+     * @brief Pushes an element from a coroutine (C++20).
+     *
+     * @details `co_await chan.async_write(value)` gives true if the element was pushed, or false if the channel is
+     * closed. If the channel is full, the coroutine is queued as a writer and resumed by the reader making space, on
+     * the reader's thread, or on an executor: `co_await chan.async_write(value).on(executor)`.
+     *
+     * @param value The element to be pushed into the channel.
+     * @return Awaitable writing the element. The channel must outlive it.
+     */
+    write_awaiter<channel> async_write(T value) { return write_awaiter<channel>{*this, std::move(value)}; }
+#endif
 
     channel(const channel&) = delete;
     channel& operator=(const channel&) = delete;
     channel(channel&&) = delete;
     channel& operator=(channel&&) = delete;
-    virtual ~channel() = default;
+
+    /**
+     * @brief Completes the reads and writes still queued with channel_status::kClosed, so their handlers are called
+     * and released.
+     */
+    virtual ~channel()
+    {
+        try {
+            // Nobody else can use the channel anymore, but serve_async() expects it to be locked.
+            detail::async_completion done;
+            std::unique_lock<std::mutex> lock{mtx_};
+            is_closed_ = true;
+            serve_async(done);
+        }
+        catch (...) {
+            // An operation whose handler could not be dispatched was deleted without calling it; a destructor cannot
+            // report it.
+        }
+    }
 
    private:
     Storage storage_;
-    std::condition_variable cnd_;
+    std::condition_variable read_cnd_;
+    std::condition_variable write_cnd_;
     mutable std::mutex mtx_;
     std::size_t capacity_{};
+    std::size_t waiting_readers_{};
+    std::size_t waiting_writers_{};
     bool is_closed_{};
+    detail::select_node* select_nodes_{};
+    detail::async_queue<detail::async_read_op<T>> async_readers_{};
+    detail::async_queue<detail::async_write_op<T>> async_writers_{};
+
+    friend struct detail::select_access;
+    friend struct detail::async_access;
+
+    Statistics& stats() noexcept { return *this; }
+
+    using spin_state_type = detail::spin_state<detail::strategy_spins<WaitStrategy>::value>;
+
+    spin_state_type& spinning() noexcept { return *this; }
+
+    const spin_state_type& spinning() const noexcept { return *this; }
+
+    // Locks the channel for an operation, through the statistics policy so it can count contention.
+    std::unique_lock<std::mutex> lock_for_operation()
+    {
+        std::unique_lock<std::mutex> lock{mtx_, std::defer_lock};
+        stats().acquire(lock);
+        return lock;
+    }
+
+    bool can_read() const noexcept { return storage_.size() > 0 || is_closed_; }
+
+    bool can_write() const noexcept { return capacity_ == 0 || storage_.size() < capacity_ || is_closed_; }
 
+    // Lock-free versions of can_read() and can_write() for wait strategies, which may see a stale state: the channel
+    // is locked again and checked before using it.
+    bool may_read() const noexcept { return spinning().may_read(); }
+
+    bool may_write() const noexcept { return capacity_ == 0 || spinning().may_write(capacity_); }
+
+    // Waiters are counted so the other side notifies only if someone is actually sleeping. Spinning threads are not
+    // counted, they do not need to be notified.
     void wait_before_read(std::unique_lock<std::mutex>& lock)
     {
-        cnd_.wait(lock, [this]() { return storage_.size() > 0 || is_closed_; });
-    };
+        if (can_read()) {
+            return;
+        }
+
+        const typename Statistics::time_point start = Statistics::now();
+        do {
+            if (!WaitStrategy::spin(lock, [this]() { return may_read(); })) {
+                ++waiting_readers_;
+                read_cnd_.wait(lock, [this]() { return can_read(); });
+                --waiting_readers_;
+            }
+        } while (!can_read());
+        stats().on_read_blocked(start);
+    }
+
+    template <typename Clock, typename Duration>
+    bool wait_before_read(std::unique_lock<std::mutex>& lock, const std::chrono::time_point<Clock, Duration>& deadline)
+    {
+        if (can_read()) {
+            return true;
+        }
+
+        const typename Statistics::time_point start = Statistics::now();
+        bool ready = false;
+        do {
+            if (!WaitStrategy::spin(lock, [this, &deadline]() { return may_read() || Clock::now() >= deadline; })) {
+                ++waiting_readers_;
+                ready = read_cnd_.wait_until(lock, deadline, [this]() { return can_read(); });
+                --waiting_readers_;
+                break;
+            }
+            ready = can_read();
+        } while (!ready && Clock::now() < deadline);
+        stats().on_read_blocked(start);
+
+        return ready;
+    }
 
     void wait_before_write(std::unique_lock<std::mutex>& lock)
     {
-        if (capacity_ > 0) {
-            cnd_.wait(lock, [this]() { return storage_.size() < capacity_; });
+        if (can_write()) {
+            return;
+        }
+
+        const typename Statistics::time_point start = Statistics::now();
+        do {
+            if (!WaitStrategy::spin(lock, [this]() { return may_write(); })) {
+                ++waiting_writers_;
+                write_cnd_.wait(lock, [this]() { return can_write(); });
+                --waiting_writers_;
+            }
+        } while (!can_write());
+        stats().on_write_blocked(start);
+    }
+
+    template <typename Clock, typename Duration>
+    bool wait_before_write(std::unique_lock<std::mutex>& lock, const std::chrono::time_point<Clock, Duration>& deadline)
+    {
+        if (can_write()) {
+            return true;
+        }
+
+        const typename Statistics::time_point start = Statistics::now();
+        bool ready = false;
+        do {
+            if (!WaitStrategy::spin(lock, [this, &deadline]() { return may_write() || Clock::now() >= deadline; })) {
+                ++waiting_writers_;
+                ready = write_cnd_.wait_until(lock, deadline, [this]() { return can_write(); });
+                --waiting_writers_;
+                break;
+            }
+            ready = can_write();
+        } while (!ready && Clock::now() < deadline);
+        stats().on_write_blocked(start);
+
+        return ready;
+    }
+
+    void subscribe(detail::select_node& node)
+    {
+        std::unique_lock<std::mutex> lock{mtx_};
+        node.prev = nullptr;
+        node.next = select_nodes_;
+        if (select_nodes_ != nullptr) {
+            select_nodes_->prev = &node;
+        }
+        select_nodes_ = &node;
+    }
+
+    void unsubscribe(detail::select_node& node)
+    {
+        std::unique_lock<std::mutex> lock{mtx_};
+        if (node.prev != nullptr) {
+            node.prev->next = node.next;
+        }
+        else {
+            select_nodes_ = node.next;
+        }
+        if (node.next != nullptr) {
+            node.next->prev = node.prev;
+        }
+        node.prev = nullptr;
+        node.next = nullptr;
+    }
+
+    bool start_async_read(detail::async_read_op<T>& op)
+    {
+        detail::async_completion done;
+        std::unique_lock<std::mutex> lock = lock_for_operation();
+
+        if (storage_.size() == 0) {
+            if (!is_closed_) {
+                async_readers_.push(op);
+                return false;
+            }
+
+            op.status = channel_status::kClosed;
+            return true;
+        }
+
+        storage_.pop_front(*op.out);
+        stats().on_read(1);
+        op.status = channel_status::kOk;
+        signal_waiters(done);
+        if (waiting_writers_ > 0) {
+            write_cnd_.notify_one();
+        }
+
+        return true;
+    }
+
+    bool start_async_write(detail::async_write_op<T>& op)
+    {
+        detail::async_completion done;
+        std::unique_lock<std::mutex> lock = lock_for_operation();
+
+        if (is_closed_) {
+            op.status = channel_status::kClosed;
+            return true;
+        }
+
+        // Writers queued before this one go first.
+        if (!async_writers_.empty() || (capacity_ > 0 && storage_.size() >= capacity_)) {
+            async_writers_.push(op);
+            return false;
+        }
+
+        storage_.push_back(std::move(*op.in));
+        stats().on_write(1, storage_.size());
+        op.status = channel_status::kOk;
+        signal_waiters(done);
+        if (waiting_readers_ > 0) {
+            read_cnd_.notify_one();
+        }
+
+        return true;
+    }
+
+    // Called with the lock held on every change a select or an asynchronous operation could be waiting for. The
+    // operations served are completed by **done** after the lock is released.
+    void signal_waiters(detail::async_completion& done)
+    {
+        for (const detail::select_node* node = select_nodes_; node != nullptr; node = node->next) {
+            node->waiter->signal();
+        }
+
+        if (!async_readers_.empty() || !async_writers_.empty()) {
+            serve_async(done);
+        }
+
+        spinning().publish(storage_.size(), is_closed_);
+    }
+
+    void serve_async(detail::async_completion& done)
+    {
+        bool popped{};
+        bool pushed{};
+        bool progress = true;
+        while (progress) {
+            progress = false;
+
+            while (!async_readers_.empty() && storage_.size() > 0) {
+                detail::async_read_op<T>& op = async_readers_.pop();
+                storage_.pop_front(*op.out);
+                stats().on_read(1);
+                op.status = channel_status::kOk;
+                done.add(op);
+                popped = progress = true;
+            }
+
+            while (!is_closed_ && !async_writers_.empty() && (capacity_ == 0 || storage_.size() < capacity_)) {
+                detail::async_write_op<T>& op = async_writers_.pop();
+                storage_.push_back(std::move(*op.in));
+                stats().on_write(1, storage_.size());
+                op.status = channel_status::kOk;
+                done.add(op);
+                pushed = progress = true;
+            }
+        }
+
+        if (is_closed_) {
+            while (!async_writers_.empty()) {
+                detail::async_write_op<T>& op = async_writers_.pop();
+                op.status = channel_status::kClosed;
+                done.add(op);
+            }
+
+            while (storage_.size() == 0 && !async_readers_.empty()) {
+                detail::async_read_op<T>& op = async_readers_.pop();
+                op.status = channel_status::kClosed;
+                done.add(op);
+            }
+        }
+
+        // Synchronous waiters on the other side might now be able to progress.
+        if (popped && waiting_writers_ > 0) {
+            write_cnd_.notify_all();
+        }
+        if (pushed && waiting_readers_ > 0) {
+            read_cnd_.notify_all();
         }
     }
 };
@@ -307,9 +1167,9 @@ class channel {
 /**
  * @copydoc msd::channel::operator<<
  */
-template <typename T, typename Storage>
-channel<typename std::decay<T>::type, Storage>& operator<<(channel<typename std::decay<T>::type, Storage>& chan,
-                                                           T&& value)
+template <typename T, typename Storage, typename WaitStrategy, typename Statistics>
+channel<typename std::decay<T>::type, Storage, WaitStrategy, Statistics>& operator<<(
+    channel<typename std::decay<T>::type, Storage, WaitStrategy, Statistics>& chan, T&& value)
 {
     if (!chan.write(std::forward<T>(value))) {
         throw closed_channel{"cannot write on closed channel"};
@@ -321,14 +1181,34 @@ channel<typename std::decay<T>::type, Storage>& operator<<(channel<typename std:
 /**
  * @copydoc msd::channel::operator>>
  */
-template <typename T, typename Storage>
-channel<T, Storage>& operator>>(channel<T, Storage>& chan, T& out)
+template <typename T, typename Storage, typename WaitStrategy, typename Statistics>
+channel<T, Storage, WaitStrategy, Statistics>& operator>>(channel<T, Storage, WaitStrategy, Statistics>& chan, T& out)
 {
     chan.read(out);
 
     return chan;
 }
 
+#ifdef MSD_CHANNEL_HAS_PMR
+namespace pmr {
+
+/**
+ * @brief Channel whose storage allocates from a std::pmr::memory_resource (C++17).
+ *
+ * @details Construct it with a capacity and a memory resource: `msd::pmr::channel<int> chan{10, &resource};`.
+ *
+ * @tparam T The type of the elements.
+ * @tparam Storage The storage type, using std::pmr::polymorphic_allocator. Default: msd::pmr::queue_storage.
+ * @tparam WaitStrategy What to do before parking a thread that cannot make progress. Default: msd::blocking_wait.
+ * @tparam Statistics What to record about the operations. Default: msd::no_statistics.
+ */
+template <typename T, typename Storage = queue_storage<T>, typename WaitStrategy = blocking_wait,
+          typename Statistics = no_statistics>
+using channel = msd::channel<T, Storage, WaitStrategy, Statistics>;
+
+}  // namespace pmr
+#endif
+
 }  // namespace msd
 
 #endif  // MSD_CHANNEL_CHANNEL_HPP_
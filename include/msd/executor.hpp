@@ -0,0 +1,613 @@
+// Copyright (C) 2020-2025 Andrei Avram
+
+#ifndef MSD_CHANNEL_EXECUTOR_HPP_
+#define MSD_CHANNEL_EXECUTOR_HPP_
+
+#include "nodiscard.hpp"
+#include "parking.hpp"
+#include "status.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/** @file */
+
+namespace msd {
+
+class executor;
+
+namespace detail {
+
+/**
+ * @brief The executor and worker the current thread belongs to, if any.
+ */
+struct worker_context {
+    /**
+     * @brief The executor owning the current thread (null if not a worker).
+     */
+    const executor* owner;
+
+    /**
+     * @brief Index of the worker within its executor.
+     */
+    std::size_t index;
+};
+
+/**
+ * @brief Returns the worker context of the current thread.
+ *
+ * @return Reference to the thread-local context.
+ */
+inline worker_context& this_worker() noexcept
+{
+    static thread_local worker_context context{nullptr, 0};
+    return context;
+}
+
+/**
+ * @brief Completion state shared by the workers of one executor stage.
+ */
+struct stage_state {
+    /**
+     * @brief Number of workers still reading the input channel.
+     */
+    std::atomic<std::size_t> running;
+
+    /**
+     * @brief Called once, after the last worker finished and before the future becomes ready.
+     */
+    std::function<void()> on_finish;
+
+    /**
+     * @brief Fulfilled when the stage finished.
+     */
+    std::promise<void> done;
+
+    /**
+     * @brief First exception thrown by the stage function.
+     */
+    std::exception_ptr error;
+
+    /**
+     * @brief Guards the error.
+     */
+    std::mutex mtx;
+
+    /**
+     * @brief Constructs the state for a given number of workers.
+     *
+     * @param workers Number of workers of the stage.
+     * @param finish Called when the stage finished.
+     */
+    stage_state(const std::size_t workers, std::function<void()> finish)
+        : running{workers}, on_finish{std::move(finish)}
+    {
+    }
+};
+
+/**
+ * @brief Completion handler ignoring its arguments, used to detect channels with callback operations.
+ */
+struct ignore_completion {
+    /**
+     * @brief Does nothing.
+     */
+    template <typename... Args>
+    void operator()(Args&&...) const noexcept
+    {
+    }
+};
+
+/**
+ * @brief Trait to check if a channel can call a handler when it can be read or written (see
+ * msd::channel::async_read and msd::channel::async_write).
+ */
+template <typename, typename = void>
+struct has_callbacks : std::false_type {};
+
+/**
+ * @brief Trait to check if a channel can call a handler when it can be read or written (see
+ * msd::channel::async_read and msd::channel::async_write).
+ *
+ * @tparam Channel The channel type to check.
+ */
+template <typename Channel>
+struct has_callbacks<Channel, decltype(std::declval<Channel&>().async_read(ignore_completion{}),
+                                       std::declval<Channel&>().async_write(
+                                           std::declval<typename Channel::value_type>(), ignore_completion{}),
+                                       void())> : std::true_type {};
+
+}  // namespace detail
+
+/**
+ * @brief Fixed-size thread pool with a work-stealing deque per worker, which can run channel pipeline stages.
+ *
+ * - Tasks posted from a worker go to the back of its own deque and are taken back in LIFO order (the data they touch
+ * is likely still in cache); idle workers steal from the front of the other deques.
+ * - Tasks posted from other threads are spread over the workers' deques.
+ * - for_each() and transform() run a stage of a channel pipeline as tasks, without a thread per stage: a stage reads a
+ * batch of elements, then yields the worker to other tasks. A stage whose input is empty or whose output is full is
+ * queued on that channel (msd::channel::async_read, msd::channel::async_write) and scheduled again by the thread that
+ * writes or reads it, so a waiting stage takes no worker and no CPU. Channels without these operations (eg:
+ * msd::spsc_channel) cannot be used by stages.
+ * - The destructor runs all queued tasks and waits for all stages to finish (close their input channels first).
+ * - Not movable, not copyable.
+ *
+ * @note Posted tasks must not throw. Exceptions thrown by the functions of a stage are stored in its future.
+ */
+class executor {
+   public:
+    /**
+     * @brief The type used to represent sizes and counts.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Number of elements a stage worker processes before yielding its worker thread.
+     */
+    static constexpr size_type stage_batch_size = 64;
+
+    /**
+     * @brief Creates an executor with one worker for each hardware thread.
+     */
+    executor() : executor{std::thread::hardware_concurrency()} {}
+
+    /**
+     * @brief Creates an executor with a given number of workers.
+     *
+     * @param threads Number of worker threads (at least one is created).
+     */
+    explicit executor(const size_type threads)
+    {
+        const size_type count = threads > 0 ? threads : 1;
+
+        queues_.reserve(count);
+        for (size_type i = 0; i < count; ++i) {
+            queues_.emplace_back(new worker_queue{});
+        }
+
+        threads_.reserve(count);
+        for (size_type i = 0; i < count; ++i) {
+            threads_.emplace_back([this, i]() { work(i); });
+        }
+    }
+
+    /**
+     * @brief Schedules a task.
+     *
+     * @tparam Function Type of the task, callable without arguments.
+     * @param task The task to run on a worker.
+     */
+    template <typename Function>
+    void post(Function&& task)
+    {
+        schedule(job{std::function<void()>{std::forward<Function>(task)}}, false);
+    }
+
+    /**
+     * @brief Runs a function for each element of a channel on the executor, until the channel is drained.
+     *
+     * @tparam Channel Type of the input channel (its value type must be default constructible), with callback
+     * operations.
+     * @tparam Function Type of the function, callable with an rvalue of the channel's value type.
+     * @param input Channel to read elements from. Must outlive the stage.
+     * @param function Function called for each element (copied for each worker of the stage).
+     * @param concurrency Number of workers reading the channel at the same time (at least one).
+     * @return Future that becomes ready when the channel was drained and all calls returned.
+     */
+    template <typename Channel, typename Function>
+    std::future<void> for_each(Channel& input, Function function, const size_type concurrency = 1)
+    {
+        using value_type = typename Channel::value_type;
+
+        return run_stage(input, concurrency, std::function<void()>{}, [&function]() {
+            return [function](value_type&& value) mutable {
+                function(std::move(value));
+                return true;
+            };
+        });
+    }
+
+    /**
+     * @brief Writes the result of a function for each element of a channel into another channel, on the executor.
+     *
+     * @details When the output is full, the result is queued on the output and the worker is released, so a full output
+     * does not block a worker that the stage reading the output might need. The output is closed when the input was
+     * drained.
+     *
+     * @tparam Input Type of the input channel (its value type must be default constructible), with callback
+     * operations.
+     * @tparam Output Type of the output channel, with callback operations.
+     * @tparam Function Type of the function, callable with an rvalue of the input's value type, returning a value of
+     * the output's value type.
+     * @param input Channel to read elements from. Must outlive the stage.
+     * @param output Channel to write results to. Must outlive the stage.
+     * @param function Function called for each element (copied for each worker of the stage).
+     * @param concurrency Number of workers reading the input at the same time (at least one).
+     * @return Future that becomes ready when the input was drained and the output was closed.
+     */
+    template <typename Input, typename Output, typename Function>
+    std::future<void> transform(Input& input, Output& output, Function function, const size_type concurrency = 1)
+    {
+        static_assert(detail::has_callbacks<Output>::value,
+                      "The output of a stage must have async_read and async_write, so a stage waiting on it does not "
+                      "take a worker");
+
+        return run_stage(input, concurrency, [&output]() { output.close(); },
+                         [&output, &function]() { return transform_sink<Input, Output, Function>{output, function}; });
+    }
+
+    /**
+     * @brief Returns the number of worker threads.
+     *
+     * @return Number of workers.
+     */
+    NODISCARD size_type threads() const noexcept { return threads_.size(); }
+
+    executor(const executor&) = delete;
+    executor& operator=(const executor&) = delete;
+    executor(executor&&) = delete;
+    executor& operator=(executor&&) = delete;
+
+    /**
+     * @brief Runs the queued tasks, waits for the stages to finish, and joins the workers.
+     */
+    ~executor()
+    {
+        stopping_.store(true, std::memory_order_seq_cst);
+        idle_.notify_all();
+
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+   private:
+    struct job {
+        std::function<void()> task;
+    };
+
+    struct worker_queue {
+        std::mutex mtx;
+        std::deque<job> jobs;
+    };
+
+    // Calls the stage function and writes the result, keeping it while the output is full.
+    template <typename Input, typename Output, typename Function>
+    class transform_sink {
+       public:
+        transform_sink(Output& output, const Function& function) : output_{output}, function_{function} {}
+
+        // Returns false if the result was kept because the output is full.
+        bool operator()(typename Input::value_type&& value)
+        {
+            typename Output::value_type result = function_(std::move(value));
+            if (output_.try_write(std::move(result)) == channel_status::kFull) {
+                pending_.reset(new typename Output::value_type{std::move(result)});
+            }
+
+            return !pending_;
+        }
+
+        bool flush()
+        {
+            if (pending_ && output_.try_write(std::move(*pending_)) != channel_status::kFull) {
+                pending_.reset();
+            }
+
+            return !pending_;
+        }
+
+        // Queues the kept result on the output, which calls resume once it is written.
+        template <typename Resume>
+        void wait(Resume resume)
+        {
+            output_.async_write(std::move(*pending_), [resume](channel_status) { resume(); });
+            pending_.reset();
+        }
+
+       private:
+        Output& output_;
+        Function function_;
+        std::unique_ptr<typename Output::value_type> pending_;
+    };
+
+    // Reads the input in batches as an executor task, rescheduling itself until the input is drained. While the input
+    // is empty or the output is full, it is queued on the channel and scheduled again when it can make progress.
+    template <typename Channel, typename Sink>
+    class stage_worker : public std::enable_shared_from_this<stage_worker<Channel, Sink>> {
+       public:
+        stage_worker(executor& exec, Channel& input, Sink sink, std::shared_ptr<detail::stage_state> state)
+            : exec_{exec}, input_{input}, sink_{std::move(sink)}, state_{std::move(state)}
+        {
+        }
+
+        void run()
+        {
+            // Once the worker is scheduled again or queued on a channel, it no longer belongs to this call; if that
+            // fails, the worker is gone and must be finished, or the executor waits for it forever.
+            try {
+                switch (process()) {
+                    case step::kDrained:
+                        break;
+                    case step::kYield:
+                        resume(true);
+                        return;
+                    case step::kInputEmpty:
+                        input_.async_read(input_ready{this->shared_from_this()});
+                        return;
+                    case step::kOutputFull:
+                        wait_output();
+                        return;
+                }
+            }
+            catch (...) {
+                fail();
+            }
+
+            finish();
+        }
+
+       private:
+        enum class step { kDrained, kYield, kInputEmpty, kOutputFull };
+
+        // Completion handler of a read queued on the input.
+        struct input_ready {
+            std::shared_ptr<stage_worker> self;
+
+            void operator()(const channel_status status, typename Channel::value_type&& value)
+            {
+                if (status == channel_status::kOk) {
+                    self->value_ = std::move(value);
+                    self->has_value_ = true;
+                }
+                self->wake();
+            }
+        };
+
+        executor& exec_;
+        Channel& input_;
+        Sink sink_;
+        std::shared_ptr<detail::stage_state> state_;
+        typename Channel::value_type value_{};
+        bool has_value_{};
+
+        step process()
+        {
+            if (!flush()) {
+                return step::kOutputFull;
+            }
+
+            // The element read by a queued read
+            if (has_value_) {
+                has_value_ = false;
+                if (!sink_(std::move(value_))) {
+                    return step::kOutputFull;
+                }
+            }
+
+            for (size_type i = 0; i < stage_batch_size; ++i) {
+                const channel_status status = input_.try_read(value_);
+                if (status == channel_status::kClosed) {
+                    return step::kDrained;
+                }
+                if (status != channel_status::kOk) {
+                    return step::kInputEmpty;
+                }
+                if (!sink_(std::move(value_))) {
+                    return step::kOutputFull;
+                }
+            }
+
+            return step::kYield;
+        }
+
+        // Schedules the worker again: at the front of the deque if it yields, at the back if it was woken.
+        void resume(const bool yield)
+        {
+            const auto self = this->shared_from_this();
+            exec_.schedule(job{[self]() { self->run(); }}, yield);
+        }
+
+        // Called by the channel the worker was queued on; the worker is finished if it cannot be scheduled again.
+        void wake() noexcept
+        {
+            try {
+                resume(false);
+            }
+            catch (...) {
+                fail();
+                finish();
+            }
+        }
+
+        // Only transform_sink reports a full output.
+        template <typename S = Sink>
+        auto wait_output() -> decltype(std::declval<S&>().wait(std::function<void()>{}))
+        {
+            const auto self = this->shared_from_this();
+            sink_.wait([self]() { self->wake(); });
+        }
+
+        template <typename S = Sink, typename... Args>
+        void wait_output(Args...)
+        {
+        }
+
+        template <typename S = Sink>
+        auto flush() -> decltype(std::declval<S&>().flush())
+        {
+            return sink_.flush();
+        }
+
+        template <typename S = Sink, typename... Args>
+        bool flush(Args...)
+        {
+            return true;
+        }
+
+        void fail() noexcept
+        {
+            std::lock_guard<std::mutex> lock{state_->mtx};
+            if (!state_->error) {
+                state_->error = std::current_exception();
+            }
+        }
+
+        void finish()
+        {
+            if (state_->running.fetch_sub(1) == 1) {
+                if (state_->on_finish) {
+                    state_->on_finish();
+                }
+
+                if (state_->error) {
+                    state_->done.set_exception(state_->error);
+                }
+                else {
+                    state_->done.set_value();
+                }
+            }
+
+            exec_.stage_worker_finished();
+        }
+    };
+
+    std::vector<std::unique_ptr<worker_queue>> queues_;
+    std::vector<std::thread> threads_;
+    std::atomic<size_type> pending_{0};
+    std::atomic<size_type> stage_workers_{0};
+    std::atomic<size_type> next_queue_{0};
+    std::atomic<bool> stopping_{false};
+    detail::parking idle_;
+
+    template <typename Channel, typename MakeSink>
+    std::future<void> run_stage(Channel& input, const size_type concurrency, std::function<void()> on_finish,
+                                MakeSink make_sink)
+    {
+        static_assert(detail::has_callbacks<Channel>::value,
+                      "The input of a stage must have async_read and async_write, so a stage waiting on it does not "
+                      "take a worker");
+
+        using sink_type = decltype(make_sink());
+        using worker_type = stage_worker<Channel, sink_type>;
+
+        const size_type workers = concurrency > 0 ? concurrency : 1;
+        const auto state = std::make_shared<detail::stage_state>(workers, std::move(on_finish));
+        std::future<void> done = state->done.get_future();
+
+        stage_workers_.fetch_add(workers, std::memory_order_seq_cst);
+        for (size_type i = 0; i < workers; ++i) {
+            const auto worker = std::make_shared<worker_type>(*this, input, make_sink(), state);
+            schedule(job{[worker]() { worker->run(); }}, false);
+        }
+
+        return done;
+    }
+
+    // Jobs from a worker go to its own deque; a yielding job goes to the front, where it is stolen or taken last.
+    void schedule(job&& item, const bool yield)
+    {
+        const detail::worker_context& context = detail::this_worker();
+        const size_type index = context.owner == this
+                                    ? context.index
+                                    : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+
+        // Counted before pushing, so the worker taking the job never sees the counter going below zero
+        pending_.fetch_add(1, std::memory_order_seq_cst);
+
+        try {
+            worker_queue& queue = *queues_[index];
+            std::lock_guard<std::mutex> lock{queue.mtx};
+            if (yield) {
+                queue.jobs.push_front(std::move(item));
+            }
+            else {
+                queue.jobs.push_back(std::move(item));
+            }
+        }
+        catch (...) {
+            pending_.fetch_sub(1, std::memory_order_seq_cst);
+            throw;
+        }
+
+        idle_.notify_one();
+    }
+
+    bool take(const size_type index, job& out)
+    {
+        {
+            worker_queue& own = *queues_[index];
+            std::lock_guard<std::mutex> lock{own.mtx};
+            if (!own.jobs.empty()) {
+                out = std::move(own.jobs.back());
+                own.jobs.pop_back();
+                taken();
+                return true;
+            }
+        }
+
+        for (size_type i = 1; i < queues_.size(); ++i) {
+            worker_queue& victim = *queues_[(index + i) % queues_.size()];
+            std::lock_guard<std::mutex> lock{victim.mtx};
+            if (!victim.jobs.empty()) {
+                out = std::move(victim.jobs.front());
+                victim.jobs.pop_front();
+                taken();
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void taken() noexcept { pending_.fetch_sub(1, std::memory_order_seq_cst); }
+
+    // Stages may be queued on their channels, not on a deque: a stopping executor waits for them to finish.
+    void stage_worker_finished() noexcept
+    {
+        if (stage_workers_.fetch_sub(1, std::memory_order_seq_cst) == 1) {
+            idle_.notify_all();
+        }
+    }
+
+    bool stopped() const noexcept
+    {
+        return stopping_.load(std::memory_order_seq_cst) && pending_.load(std::memory_order_seq_cst) == 0 &&
+               stage_workers_.load(std::memory_order_seq_cst) == 0;
+    }
+
+    void work(const size_type index)
+    {
+        detail::this_worker() = detail::worker_context{this, index};
+
+        job item{};
+        while (true) {
+            if (take(index, item)) {
+                item.task();
+                item.task = nullptr;
+                continue;
+            }
+
+            if (stopped()) {
+                return;
+            }
+
+            idle_.wait([this]() { return pending_.load(std::memory_order_seq_cst) > 0 || stopped(); });
+        }
+    }
+};
+
+}  // namespace msd
+
+#endif  // MSD_CHANNEL_EXECUTOR_HPP_
@@ -0,0 +1,230 @@
+// Copyright (C) 2020-2025 Andrei Avram
+
+#ifndef MSD_CHANNEL_LATENCY_HPP_
+#define MSD_CHANNEL_LATENCY_HPP_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+/** @file */
+
+namespace msd {
+
+namespace detail {
+
+/**
+ * @brief Returns the number of bits needed to represent a value.
+ *
+ * @param value The value.
+ * @return 0 for 0, otherwise the position of the highest set bit plus one.
+ */
+inline std::size_t bit_width(std::uint64_t value) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return value == 0 ? 0 : 64 - static_cast<std::size_t>(__builtin_clzll(value));
+#else
+    std::size_t width = 0;
+    while (value != 0) {
+        ++width;
+        value >>= 1U;
+    }
+    return width;
+#endif
+}
+
+}  // namespace detail
+
+/**
+ * @brief Copy of the counters of a msd::latency_histogram.
+ */
+struct latency_snapshot {
+    /**
+     * @brief Number of buckets: bucket **i** counts the latencies needing **i** bits in nanoseconds.
+     */
+    static constexpr std::size_t bucket_count = 64;
+
+    /**
+     * @brief Number of latencies recorded in each bucket.
+     */
+    std::array<std::uint64_t, bucket_count> buckets{};
+
+    /**
+     * @brief Number of latencies recorded.
+     */
+    std::uint64_t count{};
+
+    /**
+     * @brief Sum of the latencies recorded.
+     */
+    std::chrono::nanoseconds sum{};
+
+    /**
+     * @brief Largest latency recorded.
+     */
+    std::chrono::nanoseconds max{};
+
+    /**
+     * @brief Returns the latency below which a given fraction of the recorded latencies are.
+     *
+     * @details Reports the upper bound of the bucket (limited to max), so it overestimates by less than a factor of
+     * two.
+     *
+     * @param quantile Fraction between 0 and 1 (eg: 0.99 for p99).
+     * @return The latency, or zero if nothing was recorded.
+     */
+    std::chrono::nanoseconds percentile(const double quantile) const noexcept
+    {
+        if (count == 0) {
+            return std::chrono::nanoseconds{0};
+        }
+
+        const double wanted = quantile * static_cast<double>(count);
+        std::uint64_t rank = static_cast<std::uint64_t>(wanted);
+        if (static_cast<double>(rank) < wanted || rank == 0) {
+            ++rank;
+        }
+
+        std::uint64_t seen = 0;
+        for (std::size_t bucket = 0; bucket < bucket_count; ++bucket) {
+            seen += buckets[bucket];
+            if (seen >= rank) {
+                const std::chrono::nanoseconds upper{bucket_upper_bound(bucket)};
+                return upper < max ? upper : max;
+            }
+        }
+
+        return max;
+    }
+
+    /**
+     * @brief Returns the median latency.
+     *
+     * @return percentile(0.5)
+     */
+    std::chrono::nanoseconds p50() const noexcept { return percentile(0.5); }
+
+    /**
+     * @brief Returns the 99th percentile latency.
+     *
+     * @return percentile(0.99)
+     */
+    std::chrono::nanoseconds p99() const noexcept { return percentile(0.99); }
+
+    /**
+     * @brief Returns the 99.9th percentile latency.
+     *
+     * @return percentile(0.999)
+     */
+    std::chrono::nanoseconds p999() const noexcept { return percentile(0.999); }
+
+   private:
+    static std::chrono::nanoseconds::rep bucket_upper_bound(const std::size_t bucket) noexcept
+    {
+        if (bucket == 0) {
+            return 0;
+        }
+        if (bucket >= bucket_count - 1) {
+            return std::numeric_limits<std::chrono::nanoseconds::rep>::max();
+        }
+
+        return static_cast<std::chrono::nanoseconds::rep>((std::uint64_t{1} << bucket) - 1);
+    }
+};
+
+/**
+ * @brief Lock-free histogram of latencies, with power-of-two buckets in nanoseconds.
+ *
+ * @details Any thread can record while others read it. A snapshot is not taken atomically across buckets, so it can
+ * miss latencies recorded while it is taken; scrape() never loses or double counts them.
+ */
+class latency_histogram {
+   public:
+    /**
+     * @brief Number of buckets.
+     */
+    static constexpr std::size_t bucket_count = latency_snapshot::bucket_count;
+
+    latency_histogram() = default;
+
+    /**
+     * @brief Records a latency.
+     *
+     * @param latency The latency, negative values are recorded as zero.
+     */
+    void record(const std::chrono::nanoseconds latency) noexcept
+    {
+        const std::uint64_t nanoseconds = latency.count() > 0 ? static_cast<std::uint64_t>(latency.count()) : 0;
+
+        buckets_[detail::bit_width(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(nanoseconds, std::memory_order_relaxed);
+
+        std::uint64_t max = max_.load(std::memory_order_relaxed);
+        while (nanoseconds > max && !max_.compare_exchange_weak(max, nanoseconds, std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * @brief Returns a copy of the counters.
+     *
+     * @return The counters.
+     */
+    latency_snapshot snapshot() const noexcept
+    {
+        latency_snapshot snap{};
+        for (std::size_t bucket = 0; bucket < bucket_count; ++bucket) {
+            snap.buckets[bucket] = buckets_[bucket].load(std::memory_order_relaxed);
+            snap.count += snap.buckets[bucket];
+        }
+        snap.sum = to_duration(sum_.load(std::memory_order_relaxed));
+        snap.max = to_duration(max_.load(std::memory_order_relaxed));
+
+        return snap;
+    }
+
+    /**
+     * @brief Returns the counters and resets them, for periodic collection.
+     *
+     * @return The counters recorded since the previous scrape() or reset().
+     */
+    latency_snapshot scrape() noexcept
+    {
+        latency_snapshot snap{};
+        for (std::size_t bucket = 0; bucket < bucket_count; ++bucket) {
+            snap.buckets[bucket] = buckets_[bucket].exchange(0, std::memory_order_relaxed);
+            snap.count += snap.buckets[bucket];
+        }
+        snap.sum = to_duration(sum_.exchange(0, std::memory_order_relaxed));
+        snap.max = to_duration(max_.exchange(0, std::memory_order_relaxed));
+
+        return snap;
+    }
+
+    /**
+     * @brief Resets the counters.
+     */
+    void reset() noexcept { scrape(); }
+
+    latency_histogram(const latency_histogram&) = delete;
+    latency_histogram& operator=(const latency_histogram&) = delete;
+    latency_histogram(latency_histogram&&) = delete;
+    latency_histogram& operator=(latency_histogram&&) = delete;
+    ~latency_histogram() = default;
+
+   private:
+    std::array<std::atomic<std::uint64_t>, bucket_count> buckets_{};
+    std::atomic<std::uint64_t> sum_{0};
+    std::atomic<std::uint64_t> max_{0};
+
+    static std::chrono::nanoseconds to_duration(const std::uint64_t nanoseconds) noexcept
+    {
+        return std::chrono::nanoseconds{static_cast<std::chrono::nanoseconds::rep>(nanoseconds)};
+    }
+};
+
+}  // namespace msd
+
+#endif  // MSD_CHANNEL_LATENCY_HPP_
@@ -0,0 +1,439 @@
+// Copyright (C) 2020-2025 Andrei Avram
+
+#ifndef MSD_CHANNEL_MPMC_CHANNEL_HPP_
+#define MSD_CHANNEL_MPMC_CHANNEL_HPP_
+
+#include "blocking_iterator.hpp"
+#include "channel.hpp"
+#include "nodiscard.hpp"
+#include "parking.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+/** @file */
+
+namespace msd {
+
+/**
+ * @brief Lock-free bounded channel for any number of writer and reader threads.
+ *
+ * - Allocates elements inside the channel object (like msd::static_channel).
+ * - Each slot of the ring has a sequence number telling if it's ready to be written or read (D. Vyukov's bounded
+ * queue), so writers and readers only contend on their own position counter instead of a mutex.
+ * - Threads are parked only when the channel is empty/full.
+ * - Not movable, not copyable.
+ * - Includes a blocking input iterator.
+ * - Always buffered (with **Capacity**).
+ *
+ * @tparam T The type of the elements.
+ * @tparam Capacity The maximum number of elements the channel can hold before blocking. Must be greater than one (a
+ * slot's sequence number could not tell "written" from "free for the next lap" with a single slot).
+ */
+template <typename T, std::size_t Capacity>
+class mpmc_channel {
+   public:
+    static_assert(is_supported_type<T>::value, "Type T does not meet all requirements.");
+    static_assert(Capacity > 1, "Capacity must be greater than one.");
+    static_assert(std::is_default_constructible<T>::value, "Type T must be default constructible.");
+
+    /**
+     * @brief The type of elements stored in the channel.
+     */
+    using value_type = T;
+
+    /**
+     * @brief The iterator type used to traverse the channel.
+     */
+    using iterator = blocking_iterator<mpmc_channel<T, Capacity>>;
+
+    /**
+     * @brief The type used to represent sizes and counts.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Creates a buffered channel with **Capacity** elements.
+     */
+    mpmc_channel()
+    {
+        for (size_type i = 0; i < Capacity; ++i) {
+            buffer_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Pushes an element into the channel.
+     *
+     * @param chan Channel to write to.
+     * @param value Value to write.
+     * @return Instance of channel.
+     * @throws closed_channel if channel is closed.
+     */
+    template <typename Type, std::size_t Cap>
+    friend mpmc_channel<typename std::decay<Type>::type, Cap>& operator<<(
+        mpmc_channel<typename std::decay<Type>::type, Cap>& chan, Type&& value);
+
+    /**
+     * @brief Pops an element from the channel.
+     *
+     * @param chan Channel to read from.
+     * @param out Where to write read value.
+     * @return Instance of channel.
+     */
+    template <typename Type, std::size_t Cap>
+    friend mpmc_channel<Type, Cap>& operator>>(mpmc_channel<Type, Cap>& chan, Type& out);
+
+    /**
+     * @brief Pushes an element into the channel, blocking while the channel is full.
+     *
+     * @tparam Type The type of the elements.
+     * @param value The element to be pushed into the channel.
+     * @return true If an element was successfully pushed into the channel.
+     * @return false If the channel is closed.
+     */
+    template <typename Type>
+    bool write(Type&& value)
+    {
+        while (true) {
+            const channel_status status = try_write(std::forward<Type>(value));
+            if (status != channel_status::kFull) {
+                return status == channel_status::kOk;
+            }
+
+            writers_.wait([this]() { return can_write(); });
+        }
+    }
+
+    /**
+     * @brief Pushes an element into the channel if there is space, without waiting.
+     *
+     * @tparam Type The type of the elements.
+     * @param value The element to be pushed into the channel. Not moved from if it is not pushed.
+     * @return channel_status::kOk If the element was pushed.
+     * @return channel_status::kFull If the channel is full.
+     * @return channel_status::kClosed If the channel is closed.
+     */
+    template <typename Type>
+    channel_status try_write(Type&& value)
+    {
+        size_type pos = write_index_.load(std::memory_order_relaxed);
+
+        while (true) {
+            if (is_closed(pos)) {
+                return channel_status::kClosed;
+            }
+
+            slot& cell = buffer_[pos % Capacity];
+            const size_type sequence = cell.sequence.load(std::memory_order_acquire);
+
+            if (sequence == pos) {
+                // The position is claimed only if the channel is not closed (the closed flag is part of the index).
+                if (write_index_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = std::forward<Type>(value);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    // Parked readers wait for the slot at the read position, which may not be this one.
+                    readers_.notify_all();
+
+                    return channel_status::kOk;
+                }
+            }
+            else if (sequence < pos) {
+                // The slot still holds the element written one lap ago.
+                return channel_status::kFull;
+            }
+            else {
+                pos = write_index_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Pushes an element into the channel, waiting for space until a deadline.
+     *
+     * @tparam Type The type of the elements.
+     * @tparam Clock The clock of the deadline.
+     * @tparam Duration The duration type of the deadline.
+     * @param value The element to be pushed into the channel. Not moved from if the channel is full.
+     * @param deadline Point in time after which to give up waiting.
+     * @return channel_status::kOk If the element was pushed.
+     * @return channel_status::kTimeout If the channel was full until the deadline.
+     * @return channel_status::kClosed If the channel is closed.
+     */
+    template <typename Type, typename Clock, typename Duration>
+    channel_status write_until(Type&& value, const std::chrono::time_point<Clock, Duration>& deadline)
+    {
+        while (true) {
+            const channel_status status = try_write(std::forward<Type>(value));
+            if (status != channel_status::kFull) {
+                return status;
+            }
+
+            if (!writers_.wait_until(deadline, [this]() { return can_write(); })) {
+                return channel_status::kTimeout;
+            }
+        }
+    }
+
+    /**
+     * @brief Pushes an element into the channel, waiting for space at most a given duration.
+     *
+     * @tparam Type The type of the elements.
+     * @tparam Rep The arithmetic type of the duration.
+     * @tparam Period The period of the duration.
+     * @param value The element to be pushed into the channel. Not moved from if the channel is full.
+     * @param timeout Maximum duration to wait for.
+     * @return channel_status::kOk If the element was pushed.
+     * @return channel_status::kTimeout If the channel was full for the whole duration.
+     * @return channel_status::kClosed If the channel is closed.
+     */
+    template <typename Type, typename Rep, typename Period>
+    channel_status write_for(Type&& value, const std::chrono::duration<Rep, Period>& timeout)
+    {
+        return write_until(std::forward<Type>(value), std::chrono::steady_clock::now() + timeout);
+    }
+
+    /**
+     * @brief Pops an element from the channel, blocking while the channel is empty.
+     *
+     * @param out Reference to the variable where the popped element will be stored.
+     * @return true If an element was successfully read from the channel.
+     * @return false If the channel is closed and empty.
+     */
+    bool read(T& out)
+    {
+        while (true) {
+            const channel_status status = try_read(out);
+            if (status != channel_status::kEmpty) {
+                return status == channel_status::kOk;
+            }
+
+            readers_.wait([this]() { return can_read(); });
+        }
+    }
+
+    /**
+     * @brief Pops an element from the channel if there is one, without waiting.
+     *
+     * @param out Reference to the variable where the popped element will be stored.
+     * @return channel_status::kOk If an element was read.
+     * @return channel_status::kEmpty If the channel is empty (or an element is being written).
+     * @return channel_status::kClosed If the channel is closed and empty.
+     */
+    channel_status try_read(T& out)
+    {
+        size_type pos = read_index_.load(std::memory_order_relaxed);
+
+        while (true) {
+            slot& cell = buffer_[pos % Capacity];
+            const size_type sequence = cell.sequence.load(std::memory_order_acquire);
+
+            if (sequence == pos + 1) {
+                if (read_index_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    out = std::move(cell.value);
+                    cell.sequence.store(pos + Capacity, std::memory_order_release);
+                    // Parked writers wait for the slot at the write position, which may not be this one.
+                    writers_.notify_all();
+
+                    return channel_status::kOk;
+                }
+            }
+            else if (sequence < pos + 1) {
+                // Empty, or a writer claimed the position but did not finish writing yet.
+                return is_drained(pos) ? channel_status::kClosed : channel_status::kEmpty;
+            }
+            else {
+                pos = read_index_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Pops an element from the channel, waiting for one until a deadline.
+     *
+     * @tparam Clock The clock of the deadline.
+     * @tparam Duration The duration type of the deadline.
+     * @param out Reference to the variable where the popped element will be stored.
+     * @param deadline Point in time after which to give up waiting.
+     * @return channel_status::kOk If an element was read.
+     * @return channel_status::kTimeout If the channel was empty until the deadline.
+     * @return channel_status::kClosed If the channel is closed and empty.
+     */
+    template <typename Clock, typename Duration>
+    channel_status read_until(T& out, const std::chrono::time_point<Clock, Duration>& deadline)
+    {
+        while (true) {
+            const channel_status status = try_read(out);
+            if (status != channel_status::kEmpty) {
+                return status;
+            }
+
+            if (!readers_.wait_until(deadline, [this]() { return can_read(); })) {
+                return channel_status::kTimeout;
+            }
+        }
+    }
+
+    /**
+     * @brief Pops an element from the channel, waiting for one at most a given duration.
+     *
+     * @tparam Rep The arithmetic type of the duration.
+     * @tparam Period The period of the duration.
+     * @param out Reference to the variable where the popped element will be stored.
+     * @param timeout Maximum duration to wait for.
+     * @return channel_status::kOk If an element was read.
+     * @return channel_status::kTimeout If the channel was empty for the whole duration.
+     * @return channel_status::kClosed If the channel is closed and empty.
+     */
+    template <typename Rep, typename Period>
+    channel_status read_for(T& out, const std::chrono::duration<Rep, Period>& timeout)
+    {
+        return read_until(out, std::chrono::steady_clock::now() + timeout);
+    }
+
+    /**
+     * @brief Returns the current size of the channel.
+     *
+     * @return The number of elements in the channel.
+     */
+    NODISCARD size_type size() const noexcept
+    {
+        const size_type head = read_index_.load(std::memory_order_acquire);
+        const size_type tail = index(write_index_.load(std::memory_order_acquire));
+        const size_type count = tail - head;
+
+        return count < Capacity ? count : Capacity;
+    }
+
+    /**
+     * @brief Checks if the channel is empty.
+     *
+     * @return true If the channel contains no elements.
+     * @return false Otherwise.
+     */
+    NODISCARD bool empty() const noexcept { return size() == 0; }
+
+    /**
+     * @brief Closes the channel, no longer accepting new elements.
+     */
+    void close() noexcept
+    {
+        write_index_.fetch_or(closed_flag, std::memory_order_acq_rel);
+        readers_.notify_all();
+        writers_.notify_all();
+    }
+
+    /**
+     * @brief Checks if the channel has been closed.
+     *
+     * @return true If no more elements can be added to the channel.
+     * @return false Otherwise.
+     */
+    NODISCARD bool closed() const noexcept { return is_closed(write_index_.load(std::memory_order_acquire)); }
+
+    /**
+     * @brief Checks if the channel has been closed and is empty.
+     *
+     * @return true If nothing can be read anymore from the channel.
+     * @return false Otherwise.
+     */
+    NODISCARD bool drained() noexcept { return is_drained(read_index_.load(std::memory_order_acquire)); }
+
+    /**
+     * @brief Returns an iterator to the beginning of the channel.
+     *
+     * @return A blocking iterator pointing to the start of the channel.
+     */
+    iterator begin() noexcept { return blocking_iterator<mpmc_channel<T, Capacity>>{*this}; }
+
+    /**
+     * @brief Returns an iterator representing the end of the channel.
+     *
+     * @return A blocking iterator representing the end condition.
+     */
+    iterator end() noexcept { return blocking_iterator<mpmc_channel<T, Capacity>>{*this, true}; }
+
+    mpmc_channel(const mpmc_channel&) = delete;
+    mpmc_channel& operator=(const mpmc_channel&) = delete;
+    mpmc_channel(mpmc_channel&&) = delete;
+    mpmc_channel& operator=(mpmc_channel&&) = delete;
+    virtual ~mpmc_channel() = default;
+
+   private:
+    // The closed state lives in the highest bit of the write index, so closing and claiming a slot cannot race.
+    static constexpr size_type closed_flag = size_type{1} << (std::numeric_limits<size_type>::digits - 1);
+
+    struct slot {
+        std::atomic<size_type> sequence{0};
+        T value{};
+    };
+
+    std::atomic<size_type> write_index_{0};
+    char write_padding_[detail::cache_line_size - sizeof(std::atomic<size_type>)]{};
+
+    std::atomic<size_type> read_index_{0};
+    char read_padding_[detail::cache_line_size - sizeof(std::atomic<size_type>)]{};
+
+    detail::parking readers_;
+    detail::parking writers_;
+    std::array<slot, Capacity> buffer_{};
+
+    static constexpr bool is_closed(const size_type pos) noexcept { return (pos & closed_flag) != 0; }
+
+    static constexpr size_type index(const size_type pos) noexcept { return pos & ~closed_flag; }
+
+    // Closed, and every claimed position before the read position was already read.
+    bool is_drained(const size_type pos) const noexcept
+    {
+        const size_type tail = write_index_.load(std::memory_order_acquire);
+        return is_closed(tail) && index(tail) <= pos;
+    }
+
+    bool can_write() const noexcept
+    {
+        const size_type pos = write_index_.load(std::memory_order_acquire);
+        return is_closed(pos) || buffer_[pos % Capacity].sequence.load(std::memory_order_acquire) >= pos;
+    }
+
+    bool can_read() const noexcept
+    {
+        const size_type pos = read_index_.load(std::memory_order_acquire);
+        return buffer_[pos % Capacity].sequence.load(std::memory_order_acquire) >= pos + 1 || is_drained(pos);
+    }
+};
+
+template <typename T, std::size_t Capacity>
+constexpr typename mpmc_channel<T, Capacity>::size_type mpmc_channel<T, Capacity>::closed_flag;
+
+/**
+ * @copydoc msd::mpmc_channel::operator<<
+ */
+template <typename T, std::size_t Capacity>
+mpmc_channel<typename std::decay<T>::type, Capacity>& operator<<(
+    mpmc_channel<typename std::decay<T>::type, Capacity>& chan, T&& value)
+{
+    if (!chan.write(std::forward<T>(value))) {
+        throw closed_channel{"cannot write on closed channel"};
+    }
+
+    return chan;
+}
+
+/**
+ * @copydoc msd::mpmc_channel::operator>>
+ */
+template <typename T, std::size_t Capacity>
+mpmc_channel<T, Capacity>& operator>>(mpmc_channel<T, Capacity>& chan, T& out)
+{
+    chan.read(out);
+
+    return chan;
+}
+
+}  // namespace msd
+
+#endif  // MSD_CHANNEL_MPMC_CHANNEL_HPP_
@@ -0,0 +1,210 @@
+// Copyright (C) 2020-2025 Andrei Avram
+
+#ifndef MSD_CHANNEL_PARKING_HPP_
+#define MSD_CHANNEL_PARKING_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+/** @file */
+
+// ThreadSanitizer does not support standalone fences; it gets a read-modify-write on the waiter count instead.
+#if defined(__SANITIZE_THREAD__)
+#define MSD_CHANNEL_TSAN
+#elif defined(__has_feature)
+#if __has_feature(thread_sanitizer)
+#define MSD_CHANNEL_TSAN
+#endif
+#endif
+
+namespace msd {
+
+namespace detail {
+
+/**
+ * @brief Size used to keep atomics written by different threads on separate cache lines.
+ */
+constexpr std::size_t cache_line_size = 64;
+
+/**
+ * @brief Place where threads of a lock-free channel sleep when they cannot make progress.
+ *
+ * @details The notifying side only touches the mutex if a thread is parked, so the uncontended path is a fence and a
+ * plain load of the waiter count, without writing to the shared cache line. The state checked by the predicate must be
+ * published before notifying.
+ */
+class parking {
+   public:
+    /**
+     * @brief Blocks the current thread until the predicate is satisfied.
+     *
+     * @param pred Condition to wait for.
+     */
+    template <typename Predicate>
+    void wait(Predicate pred)
+    {
+        std::unique_lock<std::mutex> lock{mtx_};
+        announce();
+
+        cnd_.wait(lock, pred);
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Blocks the current thread until the predicate is satisfied or the deadline passes.
+     *
+     * @param deadline Point in time after which to give up waiting.
+     * @param pred Condition to wait for.
+     * @return The value of the predicate when returning (false means timeout).
+     */
+    template <typename Clock, typename Duration, typename Predicate>
+    bool wait_until(const std::chrono::time_point<Clock, Duration>& deadline, Predicate pred)
+    {
+        std::unique_lock<std::mutex> lock{mtx_};
+        announce();
+        const bool ready = cnd_.wait_until(lock, deadline, pred);
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+
+        return ready;
+    }
+
+    /**
+     * @brief Wakes up one parked thread, if any.
+     *
+     * @details Only for predicates that any parked thread can satisfy after the published change; otherwise use
+     * notify_all().
+     */
+    void notify_one() noexcept
+    {
+        if (has_waiters()) {
+            cnd_.notify_one();
+        }
+    }
+
+    /**
+     * @brief Wakes up all parked threads, if any.
+     */
+    void notify_all() noexcept
+    {
+        if (has_waiters()) {
+            cnd_.notify_all();
+        }
+    }
+
+   private:
+    std::mutex mtx_;
+    std::condition_variable cnd_;
+    std::atomic<std::size_t> waiters_{0};
+
+    void announce() noexcept
+    {
+#ifdef MSD_CHANNEL_TSAN
+        waiters_.fetch_add(1, std::memory_order_acq_rel);
+#else
+        waiters_.fetch_add(1, std::memory_order_relaxed);
+        // Pairs with the fence in has_waiters(): either the notifier sees this waiter or the predicate, checked after
+        // this fence, sees the state published before notifying.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+#endif
+    }
+
+    bool has_waiters() noexcept
+    {
+#ifdef MSD_CHANNEL_TSAN
+        const std::size_t waiters = waiters_.fetch_add(0, std::memory_order_acq_rel);
+#else
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const std::size_t waiters = waiters_.load(std::memory_order_relaxed);
+#endif
+        if (waiters == 0) {
+            return false;
+        }
+
+        // A waiter may have checked the predicate but not be sleeping yet; it releases the mutex only when it sleeps.
+        std::lock_guard<std::mutex> lock{mtx_};
+        return true;
+    }
+};
+
+/**
+ * @brief Wait primitive of an msd::select, signaled by any of the channels it is registered on.
+ */
+class select_waiter {
+   public:
+    /**
+     * @brief Marks the waiter as signaled and wakes it up.
+     */
+    void signal() noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock{mtx_};
+            signaled_ = true;
+        }
+        cnd_.notify_one();
+    }
+
+    /**
+     * @brief Clears the signal, so only later changes of the channels wake the waiter up.
+     */
+    void reset() noexcept
+    {
+        std::lock_guard<std::mutex> lock{mtx_};
+        signaled_ = false;
+    }
+
+    /**
+     * @brief Blocks the current thread until the waiter is signaled.
+     */
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock{mtx_};
+        cnd_.wait(lock, [this]() { return signaled_; });
+    }
+
+    /**
+     * @brief Blocks the current thread until the waiter is signaled or the deadline passes.
+     *
+     * @param deadline Point in time after which to give up waiting.
+     * @return false If the deadline passed without a signal.
+     */
+    template <typename Clock, typename Duration>
+    bool wait_until(const std::chrono::time_point<Clock, Duration>& deadline)
+    {
+        std::unique_lock<std::mutex> lock{mtx_};
+        return cnd_.wait_until(lock, deadline, [this]() { return signaled_; });
+    }
+
+   private:
+    std::mutex mtx_;
+    std::condition_variable cnd_;
+    bool signaled_{};
+};
+
+/**
+ * @brief Registration of an msd::select on a channel, linked in the channel's list of select waiters.
+ */
+struct select_node {
+    /**
+     * @brief The waiter to signal when the channel changes state.
+     */
+    select_waiter* waiter{};
+
+    /**
+     * @brief Previous registration on the same channel.
+     */
+    select_node* prev{};
+
+    /**
+     * @brief Next registration on the same channel.
+     */
+    select_node* next{};
+};
+
+}  // namespace detail
+
+}  // namespace msd
+
+#endif  // MSD_CHANNEL_PARKING_HPP_
@@ -0,0 +1,480 @@
+// Copyright (C) 2020-2025 Andrei Avram
+
+#ifndef MSD_CHANNEL_RENDEZVOUS_CHANNEL_HPP_
+#define MSD_CHANNEL_RENDEZVOUS_CHANNEL_HPP_
+
+#include "blocking_iterator.hpp"
+#include "channel.hpp"
+#include "nodiscard.hpp"
+#include "status.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+/** @file */
+
+namespace msd {
+
+/**
+ * @brief Truly unbuffered channel: a writer hands its element directly to a reader.
+ *
+ * - Does not store elements: a write blocks until a reader takes the element and a read blocks until a writer gives
+ * one (hard backpressure, no memory growth).
+ * - The element is moved (or copied, if given as lvalue) straight from the writer's object into the reader's variable,
+ * without an intermediate storage.
+ * - Writers and readers are served in arrival order.
+ * - Not movable, not copyable.
+ * - Includes a blocking input iterator.
+ *
+ * @tparam T The type of the elements.
+ */
+template <typename T>
+class rendezvous_channel {
+   public:
+    static_assert(is_supported_type<T>::value, "Type T does not meet all requirements.");
+
+    /**
+     * @brief The type of elements passed through the channel.
+     */
+    using value_type = T;
+
+    /**
+     * @brief The iterator type used to traverse the channel.
+     */
+    using iterator = blocking_iterator<rendezvous_channel<T>>;
+
+    /**
+     * @brief The type used to represent sizes and counts.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Creates an unbuffered channel.
+     */
+    rendezvous_channel() = default;
+
+    /**
+     * @brief Hands an element to a reader.
+     *
+     * @param chan Channel to write to.
+     * @param value Value to write.
+     * @return Instance of channel.
+     * @throws closed_channel if channel is closed.
+     */
+    template <typename Type>
+    friend rendezvous_channel<typename std::decay<Type>::type>& operator<<(
+        rendezvous_channel<typename std::decay<Type>::type>& chan, Type&& value);
+
+    /**
+     * @brief Takes an element from a writer.
+     *
+     * @param chan Channel to read from.
+     * @param out Where to write read value.
+     * @return Instance of channel.
+     */
+    template <typename Type>
+    friend rendezvous_channel<Type>& operator>>(rendezvous_channel<Type>& chan, Type& out);
+
+    /**
+     * @brief Hands an element to a reader, blocking until one takes it.
+     *
+     * @tparam Type The type of the elements.
+     * @param value The element to be handed over.
+     * @return true If a reader took the element.
+     * @return false If the channel is closed.
+     */
+    template <typename Type>
+    bool write(Type&& value)
+    {
+        std::unique_lock<std::mutex> lock{mtx_};
+
+        const channel_status status = hand_to_reader(std::forward<Type>(value));
+        if (status != channel_status::kFull) {
+            return status == channel_status::kOk;
+        }
+
+        party self{source(value), &take<Type>};
+        const auto wait = [&lock, &self](const party_ready& ready) {
+            self.cnd.wait(lock, ready);
+            return true;
+        };
+
+        return park(writers_, self, wait) == channel_status::kOk;
+    }
+
+    /**
+     * @brief Hands an element to a reader if one is waiting, without waiting.
+     *
+     * @tparam Type The type of the elements.
+     * @param value The element to be handed over. Not moved from if there is no reader.
+     * @return channel_status::kOk If a reader took the element.
+     * @return channel_status::kFull If no reader is waiting.
+     * @return channel_status::kClosed If the channel is closed.
+     */
+    template <typename Type>
+    channel_status try_write(Type&& value)
+    {
+        std::unique_lock<std::mutex> lock{mtx_};
+        return hand_to_reader(std::forward<Type>(value));
+    }
+
+    /**
+     * @brief Hands an element to a reader, waiting for one until a deadline.
+     *
+     * @tparam Type The type of the elements.
+     * @tparam Clock The clock of the deadline.
+     * @tparam Duration The duration type of the deadline.
+     * @param value The element to be handed over. Not moved from if no reader takes it.
+     * @param deadline Point in time after which to give up waiting.
+     * @return channel_status::kOk If a reader took the element.
+     * @return channel_status::kTimeout If no reader came until the deadline.
+     * @return channel_status::kClosed If the channel is closed.
+     */
+    template <typename Type, typename Clock, typename Duration>
+    channel_status write_until(Type&& value, const std::chrono::time_point<Clock, Duration>& deadline)
+    {
+        std::unique_lock<std::mutex> lock{mtx_};
+
+        const channel_status status = hand_to_reader(std::forward<Type>(value));
+        if (status != channel_status::kFull) {
+            return status;
+        }
+
+        party self{source(value), &take<Type>};
+        return park(writers_, self, [&lock, &self, &deadline](const party_ready& ready) {
+            return self.cnd.wait_until(lock, deadline, ready);
+        });
+    }
+
+    /**
+     * @brief Hands an element to a reader, waiting for one at most a given duration.
+     *
+     * @tparam Type The type of the elements.
+     * @tparam Rep The arithmetic type of the duration.
+     * @tparam Period The period of the duration.
+     * @param value The element to be handed over. Not moved from if no reader takes it.
+     * @param timeout Maximum duration to wait for.
+     * @return channel_status::kOk If a reader took the element.
+     * @return channel_status::kTimeout If no reader came for the whole duration.
+     * @return channel_status::kClosed If the channel is closed.
+     */
+    template <typename Type, typename Rep, typename Period>
+    channel_status write_for(Type&& value, const std::chrono::duration<Rep, Period>& timeout)
+    {
+        return write_until(std::forward<Type>(value), std::chrono::steady_clock::now() + timeout);
+    }
+
+    /**
+     * @brief Takes an element from a writer, blocking until one gives it.
+     *
+     * @param out Reference to the variable where the element will be stored.
+     * @return true If an element was read.
+     * @return false If the channel is closed.
+     */
+    bool read(T& out)
+    {
+        std::unique_lock<std::mutex> lock{mtx_};
+
+        const channel_status status = take_from_writer(out);
+        if (status != channel_status::kEmpty) {
+            return status == channel_status::kOk;
+        }
+
+        party self{std::addressof(out), nullptr};
+        const auto wait = [&lock, &self](const party_ready& ready) {
+            self.cnd.wait(lock, ready);
+            return true;
+        };
+
+        return park(readers_, self, wait) == channel_status::kOk;
+    }
+
+    /**
+     * @brief Takes an element from a writer if one is waiting, without waiting.
+     *
+     * @param out Reference to the variable where the element will be stored.
+     * @return channel_status::kOk If an element was read.
+     * @return channel_status::kEmpty If no writer is waiting.
+     * @return channel_status::kClosed If the channel is closed.
+     */
+    channel_status try_read(T& out)
+    {
+        std::unique_lock<std::mutex> lock{mtx_};
+        return take_from_writer(out);
+    }
+
+    /**
+     * @brief Takes an element from a writer, waiting for one until a deadline.
+     *
+     * @tparam Clock The clock of the deadline.
+     * @tparam Duration The duration type of the deadline.
+     * @param out Reference to the variable where the element will be stored.
+     * @param deadline Point in time after which to give up waiting.
+     * @return channel_status::kOk If an element was read.
+     * @return channel_status::kTimeout If no writer came until the deadline.
+     * @return channel_status::kClosed If the channel is closed.
+     */
+    template <typename Clock, typename Duration>
+    channel_status read_until(T& out, const std::chrono::time_point<Clock, Duration>& deadline)
+    {
+        std::unique_lock<std::mutex> lock{mtx_};
+
+        const channel_status status = take_from_writer(out);
+        if (status != channel_status::kEmpty) {
+            return status;
+        }
+
+        party self{std::addressof(out), nullptr};
+        return park(readers_, self, [&lock, &self, &deadline](const party_ready& ready) {
+            return self.cnd.wait_until(lock, deadline, ready);
+        });
+    }
+
+    /**
+     * @brief Takes an element from a writer, waiting for one at most a given duration.
+     *
+     * @tparam Rep The arithmetic type of the duration.
+     * @tparam Period The period of the duration.
+     * @param out Reference to the variable where the element will be stored.
+     * @param timeout Maximum duration to wait for.
+     * @return channel_status::kOk If an element was read.
+     * @return channel_status::kTimeout If no writer came for the whole duration.
+     * @return channel_status::kClosed If the channel is closed.
+     */
+    template <typename Rep, typename Period>
+    channel_status read_for(T& out, const std::chrono::duration<Rep, Period>& timeout)
+    {
+        return read_until(out, std::chrono::steady_clock::now() + timeout);
+    }
+
+    /**
+     * @brief Closes the channel: waiting writers and readers return without handing over elements.
+     */
+    void close() noexcept
+    {
+        std::unique_lock<std::mutex> lock{mtx_};
+        closed_ = true;
+        readers_.wake_all();
+        writers_.wake_all();
+    }
+
+    /**
+     * @brief Checks if the channel has been closed.
+     *
+     * @return true If no more elements can be handed over.
+     * @return false Otherwise.
+     */
+    NODISCARD bool closed() const noexcept
+    {
+        std::unique_lock<std::mutex> lock{mtx_};
+        return closed_;
+    }
+
+    /**
+     * @brief Checks if nothing can be read anymore. The channel holds no elements, so it's the same as closed().
+     *
+     * @return true If the channel is closed.
+     * @return false Otherwise.
+     */
+    NODISCARD bool drained() const noexcept { return closed(); }
+
+    /**
+     * @brief Returns an iterator to the beginning of the channel.
+     *
+     * @return A blocking iterator pointing to the start of the channel.
+     */
+    iterator begin() noexcept { return blocking_iterator<rendezvous_channel<T>>{*this}; }
+
+    /**
+     * @brief Returns an iterator representing the end of the channel.
+     *
+     * @return A blocking iterator representing the end condition.
+     */
+    iterator end() noexcept { return blocking_iterator<rendezvous_channel<T>>{*this, true}; }
+
+    rendezvous_channel(const rendezvous_channel&) = delete;
+    rendezvous_channel& operator=(const rendezvous_channel&) = delete;
+    rendezvous_channel(rendezvous_channel&&) = delete;
+    rendezvous_channel& operator=(rendezvous_channel&&) = delete;
+    virtual ~rendezvous_channel() = default;
+
+   private:
+    // A blocked writer or reader, living on its own stack while it waits.
+    struct party {
+        party(void* obj, void (*take_fn)(void*, T&)) : object{obj}, take{take_fn} {}
+
+        void* object;                // Writer: the element to take. Reader: the T to write the element to.
+        void (*take)(void*, T&);     // Writer only: moves or copies the element out of object.
+        party* next{};
+        bool done{};
+        std::condition_variable cnd;
+    };
+
+    // Intrusive FIFO of blocked parties.
+    class party_queue {
+       public:
+        bool empty() const noexcept { return head_ == nullptr; }
+
+        party& front() const noexcept { return *head_; }
+
+        void push(party& p) noexcept
+        {
+            p.next = nullptr;
+            if (tail_ != nullptr) {
+                tail_->next = &p;
+            }
+            else {
+                head_ = &p;
+            }
+            tail_ = &p;
+        }
+
+        void pop() noexcept
+        {
+            head_ = head_->next;
+            if (head_ == nullptr) {
+                tail_ = nullptr;
+            }
+        }
+
+        void remove(party& p) noexcept
+        {
+            party* prev{};
+            for (party* it = head_; it != nullptr; prev = it, it = it->next) {
+                if (it == &p) {
+                    if (prev != nullptr) {
+                        prev->next = p.next;
+                    }
+                    else {
+                        head_ = p.next;
+                    }
+                    if (tail_ == &p) {
+                        tail_ = prev;
+                    }
+                    return;
+                }
+            }
+        }
+
+        void wake_all() noexcept
+        {
+            for (party* it = head_; it != nullptr; it = it->next) {
+                it->cnd.notify_one();
+            }
+            head_ = nullptr;
+            tail_ = nullptr;
+        }
+
+       private:
+        party* head_{};
+        party* tail_{};
+    };
+
+    // Predicate of a parked party: handed over or closed.
+    struct party_ready {
+        const party& self;
+        const bool& closed;
+
+        bool operator()() const noexcept { return self.done || closed; }
+    };
+
+    mutable std::mutex mtx_;
+    party_queue readers_;
+    party_queue writers_;
+    bool closed_{};
+
+    template <typename Type>
+    static void* source(Type& value) noexcept
+    {
+        return const_cast<void*>(static_cast<const void*>(std::addressof(value)));
+    }
+
+    template <typename Type>
+    static void take(void* from, T& to)
+    {
+        to = std::forward<Type>(*static_cast<typename std::remove_reference<Type>::type*>(from));
+    }
+
+    // The peer is notified while the lock is held: once it sees done it returns and its party no longer exists.
+    template <typename Type>
+    channel_status hand_to_reader(Type&& value)
+    {
+        if (closed_) {
+            return channel_status::kClosed;
+        }
+
+        if (readers_.empty()) {
+            return channel_status::kFull;
+        }
+
+        party& reader = readers_.front();
+        *static_cast<T*>(reader.object) = std::forward<Type>(value);
+        readers_.pop();
+        reader.done = true;
+        reader.cnd.notify_one();
+
+        return channel_status::kOk;
+    }
+
+    channel_status take_from_writer(T& out)
+    {
+        if (writers_.empty()) {
+            return closed_ ? channel_status::kClosed : channel_status::kEmpty;
+        }
+
+        party& writer = writers_.front();
+        writer.take(writer.object, out);
+        writers_.pop();
+        writer.done = true;
+        writer.cnd.notify_one();
+
+        return channel_status::kOk;
+    }
+
+    template <typename Wait>
+    channel_status park(party_queue& queue, party& self, Wait wait)
+    {
+        queue.push(self);
+        wait(party_ready{self, closed_});
+
+        if (self.done) {
+            return channel_status::kOk;
+        }
+
+        queue.remove(self);
+        return closed_ ? channel_status::kClosed : channel_status::kTimeout;
+    }
+};
+
+/**
+ * @copydoc msd::rendezvous_channel::operator<<
+ */
+template <typename T>
+rendezvous_channel<typename std::decay<T>::type>& operator<<(rendezvous_channel<typename std::decay<T>::type>& chan,
+                                                             T&& value)
+{
+    if (!chan.write(std::forward<T>(value))) {
+        throw closed_channel{"cannot write on closed channel"};
+    }
+
+    return chan;
+}
+
+/**
+ * @copydoc msd::rendezvous_channel::operator>>
+ */
+template <typename T>
+rendezvous_channel<T>& operator>>(rendezvous_channel<T>& chan, T& out)
+{
+    chan.read(out);
+
+    return chan;
+}
+
+}  // namespace msd
+
+#endif  // MSD_CHANNEL_RENDEZVOUS_CHANNEL_HPP_
@@ -0,0 +1,482 @@
+// Copyright (C) 2020-2025 Andrei Avram
+
+#ifndef MSD_CHANNEL_SELECT_HPP_
+#define MSD_CHANNEL_SELECT_HPP_
+
+#include "channel.hpp"
+#include "parking.hpp"
+#include "status.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+/** @file */
+
+namespace msd {
+
+namespace detail {
+
+/**
+ * @brief Gives msd::select access to the waiter registration of a channel.
+ */
+struct select_access {
+    /**
+     * @brief Registers a node on a channel.
+     *
+     * @param chan Channel to register on.
+     * @param node Registration to link into the channel.
+     */
+    template <typename Channel>
+    static void subscribe(Channel& chan, select_node& node)
+    {
+        chan.subscribe(node);
+    }
+
+    /**
+     * @brief Unregisters a node from a channel.
+     *
+     * @param chan Channel to unregister from.
+     * @param node Registration to unlink from the channel.
+     */
+    template <typename Channel>
+    static void unsubscribe(Channel& chan, select_node& node)
+    {
+        chan.unsubscribe(node);
+    }
+};
+
+/**
+ * @brief A read or write case of an msd::select.
+ */
+class select_case {
+   public:
+    /**
+     * @brief Tries to complete the case without waiting.
+     *
+     * @return channel_status::kOk If the case completed and its handler was called.
+     * @return channel_status::kClosed If the case can never complete.
+     * @return Another status if the case is not ready yet.
+     */
+    virtual channel_status try_complete() = 0;
+
+    /**
+     * @brief Registers the waiter to be signaled when the channel of the case changes state.
+     *
+     * @param waiter The waiter of the select.
+     */
+    virtual void subscribe(select_waiter& waiter) = 0;
+
+    /**
+     * @brief Unregisters the waiter from the channel of the case.
+     */
+    virtual void unsubscribe() = 0;
+
+    /**
+     * @brief Whether the case can no longer complete (its channel is closed or its value was written).
+     */
+    bool done{};
+
+    select_case() = default;
+    select_case(const select_case&) = delete;
+    select_case& operator=(const select_case&) = delete;
+    select_case(select_case&&) = delete;
+    select_case& operator=(select_case&&) = delete;
+    virtual ~select_case() = default;
+};
+
+/**
+ * @brief Case of an msd::select registered on a single channel.
+ *
+ * @tparam Channel Type of the channel.
+ */
+template <typename Channel>
+class channel_case : public select_case {
+   public:
+    /**
+     * @brief Creates a case for a channel.
+     *
+     * @param chan The channel of the case.
+     */
+    explicit channel_case(Channel& chan) : chan_{chan} {}
+
+    void subscribe(select_waiter& waiter) override
+    {
+        node_.waiter = &waiter;
+        select_access::subscribe(chan_, node_);
+    }
+
+    void unsubscribe() override
+    {
+        select_access::unsubscribe(chan_, node_);
+        node_.waiter = nullptr;
+    }
+
+   protected:
+    /**
+     * @brief The channel of the case.
+     */
+    Channel& chan_;
+
+   private:
+    select_node node_{};
+};
+
+/**
+ * @brief Case of an msd::select reading from a channel.
+ */
+template <typename Channel, typename Handler, typename ClosedHandler>
+class select_read_case : public channel_case<Channel> {
+   public:
+    /**
+     * @brief Creates a read case.
+     *
+     * @param chan The channel to read from.
+     * @param handler Called with the read element.
+     * @param closed_handler Called once when the channel is closed and empty.
+     */
+    select_read_case(Channel& chan, Handler handler, ClosedHandler closed_handler)
+        : channel_case<Channel>{chan}, handler_(std::move(handler)), closed_handler_(std::move(closed_handler))
+    {
+    }
+
+    channel_status try_complete() override
+    {
+        typename Channel::value_type value{};
+        const channel_status status = this->chan_.try_read(value);
+
+        if (status == channel_status::kOk) {
+            handler_(std::move(value));
+        }
+        else if (status == channel_status::kClosed) {
+            this->done = true;
+            if (closed_handler_()) {
+                return channel_status::kOk;
+            }
+        }
+
+        return status;
+    }
+
+   private:
+    Handler handler_;
+    ClosedHandler closed_handler_;
+};
+
+/**
+ * @brief Case of an msd::select writing a value into a channel.
+ */
+template <typename Channel, typename Handler>
+class select_write_case : public channel_case<Channel> {
+   public:
+    /**
+     * @brief Creates a write case.
+     *
+     * @param chan The channel to write to.
+     * @param value The element to write.
+     * @param handler Called after the element is written.
+     */
+    select_write_case(Channel& chan, typename Channel::value_type value, Handler handler)
+        : channel_case<Channel>{chan}, value_(std::move(value)), handler_(std::move(handler))
+    {
+    }
+
+    channel_status try_complete() override
+    {
+        const channel_status status = this->chan_.try_write(std::move(value_));
+
+        if (status == channel_status::kOk) {
+            this->done = true;
+            handler_();
+        }
+        else if (status == channel_status::kClosed) {
+            this->done = true;
+        }
+
+        return status;
+    }
+
+   private:
+    typename Channel::value_type value_;
+    Handler handler_;
+};
+
+/**
+ * @brief Closed handler of read cases that do not handle closing: the case is silently disabled.
+ */
+struct ignore_closed {
+    /**
+     * @brief Does not complete the select.
+     *
+     * @return false
+     */
+    bool operator()() const noexcept { return false; }
+};
+
+/**
+ * @brief Adapts a user closed handler so that closing completes the select.
+ */
+template <typename Handler>
+struct complete_on_closed {
+    /**
+     * @brief The user handler.
+     */
+    Handler handler;
+
+    /**
+     * @brief Calls the user handler.
+     *
+     * @return true
+     */
+    bool operator()()
+    {
+        handler();
+        return true;
+    }
+};
+
+}  // namespace detail
+
+/**
+ * @brief Waits on multiple channels at once and completes exactly one ready case, like Go's select statement.
+ *
+ * @details Cases are registered with read() and write() on channels of any element and storage type. wait() first
+ * tries all cases in a random order, so that no ready case is starved. If none is ready, it registers a single waiter
+ * on all channels and sleeps until one of them changes state, then tries again. No polling and no extra threads.
+ *
+ * A select can be waited on repeatedly (eg: in a loop). Read cases can complete on each wait; a write case completes
+ * once, as its value is consumed. Cases whose channel is closed are disabled.
+ *
+ * - Not movable, not copyable.
+ * - Must be used by a single thread at a time.
+ *
+ * @code
+ * msd::select select;
+ * select.read(data, [](int value) { process(value); })
+ *     .read(shutdown, [](bool) {}, [&running]() { running = false; });
+ *
+ * while (running && select.wait()) {}
+ * @endcode
+ */
+class select {
+   public:
+    /**
+     * @brief Creates a select without cases.
+     */
+    select() : random_{std::random_device{}()} {}
+
+    /**
+     * @brief Adds a case reading from a channel.
+     *
+     * @details If the channel is closed and empty, the case is disabled without completing the select.
+     *
+     * @tparam T The type of the elements.
+     * @tparam Storage The storage type of the channel.
+     * @tparam Wait The wait strategy of the channel.
+     * @tparam Stats The statistics policy of the channel.
+     * @tparam Handler Callable with an element of type T.
+     * @param chan The channel to read from.
+     * @param handler Called with the read element when the case completes.
+     * @return Instance of select.
+     */
+    template <typename T, typename Storage, typename Wait, typename Stats, typename Handler>
+    select& read(channel<T, Storage, Wait, Stats>& chan, Handler handler)
+    {
+        using read_case = detail::select_read_case<channel<T, Storage, Wait, Stats>, Handler, detail::ignore_closed>;
+        return add(std::unique_ptr<detail::select_case>{
+            new read_case{chan, std::move(handler), detail::ignore_closed{}}});
+    }
+
+    /**
+     * @brief Adds a case reading from a channel, which also completes when the channel is closed and empty.
+     *
+     * @tparam T The type of the elements.
+     * @tparam Storage The storage type of the channel.
+     * @tparam Wait The wait strategy of the channel.
+     * @tparam Stats The statistics policy of the channel.
+     * @tparam Handler Callable with an element of type T.
+     * @tparam ClosedHandler Callable without arguments.
+     * @param chan The channel to read from.
+     * @param handler Called with the read element when the case completes.
+     * @param closed_handler Called once, when the case completes because the channel is closed and empty.
+     * @return Instance of select.
+     */
+    template <typename T, typename Storage, typename Wait, typename Stats, typename Handler, typename ClosedHandler>
+    select& read(channel<T, Storage, Wait, Stats>& chan, Handler handler, ClosedHandler closed_handler)
+    {
+        using closed = detail::complete_on_closed<ClosedHandler>;
+        using read_case = detail::select_read_case<channel<T, Storage, Wait, Stats>, Handler, closed>;
+        return add(std::unique_ptr<detail::select_case>{
+            new read_case{chan, std::move(handler), closed{std::move(closed_handler)}}});
+    }
+
+    /**
+     * @brief Adds a case writing an element into a channel.
+     *
+     * @details If the channel is closed, the case is disabled without completing the select.
+     *
+     * @tparam T The type of the elements.
+     * @tparam Storage The storage type of the channel.
+     * @tparam Wait The wait strategy of the channel.
+     * @tparam Stats The statistics policy of the channel.
+     * @tparam Handler Callable without arguments.
+     * @param chan The channel to write to.
+     * @param value The element to write.
+     * @param handler Called after the element is written.
+     * @return Instance of select.
+     */
+    template <typename T, typename Storage, typename Wait, typename Stats, typename Handler>
+    select& write(channel<T, Storage, Wait, Stats>& chan, typename channel<T, Storage, Wait, Stats>::value_type value,
+                  Handler handler)
+    {
+        using write_case = detail::select_write_case<channel<T, Storage, Wait, Stats>, Handler>;
+        return add(std::unique_ptr<detail::select_case>{new write_case{chan, std::move(value), std::move(handler)}});
+    }
+
+    /**
+     * @brief Blocks until one case completes.
+     *
+     * @return true If a case completed.
+     * @return false If no case can complete anymore (all of them are disabled).
+     */
+    bool wait()
+    {
+        const auto wait_forever = [this]() {
+            waiter_.wait();
+            return true;
+        };
+
+        return run(wait_forever) == channel_status::kOk;
+    }
+
+    /**
+     * @brief Blocks until one case completes or the deadline passes.
+     *
+     * @tparam Clock The clock of the deadline.
+     * @tparam Duration The duration type of the deadline.
+     * @param deadline Point in time after which to give up waiting.
+     * @return channel_status::kOk If a case completed.
+     * @return channel_status::kTimeout If no case was ready until the deadline.
+     * @return channel_status::kClosed If no case can complete anymore (all of them are disabled).
+     */
+    template <typename Clock, typename Duration>
+    channel_status wait_until(const std::chrono::time_point<Clock, Duration>& deadline)
+    {
+        return run([this, &deadline]() { return waiter_.wait_until(deadline); });
+    }
+
+    /**
+     * @brief Blocks until one case completes or the timeout passes.
+     *
+     * @tparam Rep The arithmetic type of the duration.
+     * @tparam Period The period of the duration.
+     * @param timeout Maximum duration to wait for.
+     * @return channel_status::kOk If a case completed.
+     * @return channel_status::kTimeout If no case was ready for the whole duration.
+     * @return channel_status::kClosed If no case can complete anymore (all of them are disabled).
+     */
+    template <typename Rep, typename Period>
+    channel_status wait_for(const std::chrono::duration<Rep, Period>& timeout)
+    {
+        return wait_until(std::chrono::steady_clock::now() + timeout);
+    }
+
+    select(const select&) = delete;
+    select& operator=(const select&) = delete;
+    select(select&&) = delete;
+    select& operator=(select&&) = delete;
+    ~select() = default;
+
+   private:
+    std::vector<std::unique_ptr<detail::select_case>> cases_;
+    std::vector<std::size_t> order_;
+    std::minstd_rand random_;
+    detail::select_waiter waiter_;
+
+    // Unregisters the waiter from all channels when leaving run(), even if a handler throws.
+    class subscription {
+       public:
+        explicit subscription(select& sel) : sel_{sel}
+        {
+            for (auto& c : sel_.cases_) {
+                c->subscribe(sel_.waiter_);
+            }
+        }
+
+        subscription(const subscription&) = delete;
+        subscription& operator=(const subscription&) = delete;
+        subscription(subscription&&) = delete;
+        subscription& operator=(subscription&&) = delete;
+
+        ~subscription()
+        {
+            for (auto& c : sel_.cases_) {
+                c->unsubscribe();
+            }
+        }
+
+       private:
+        select& sel_;
+    };
+
+    // Reserves the order first, so nothing can throw after the case is added.
+    select& add(std::unique_ptr<detail::select_case> c)
+    {
+        order_.reserve(cases_.size() + 1);
+        cases_.push_back(std::move(c));
+        order_.push_back(order_.size());
+        return *this;
+    }
+
+    // Tries the active cases in a random order, so each ready case has the same chance to be chosen.
+    channel_status try_cases()
+    {
+        std::shuffle(order_.begin(), order_.end(), random_);
+
+        bool active{};
+        for (const std::size_t i : order_) {
+            detail::select_case& c = *cases_[i];
+            if (c.done) {
+                continue;
+            }
+
+            if (c.try_complete() == channel_status::kOk) {
+                return channel_status::kOk;
+            }
+
+            active = active || !c.done;
+        }
+
+        return active ? channel_status::kEmpty : channel_status::kClosed;
+    }
+
+    template <typename Wait>
+    channel_status run(Wait wait)
+    {
+        channel_status status = try_cases();
+        if (status != channel_status::kEmpty) {
+            return status;
+        }
+
+        // Any change after the reset either is seen by the next try or signals the waiter.
+        waiter_.reset();
+        const subscription subscribed{*this};
+
+        while ((status = try_cases()) == channel_status::kEmpty) {
+            if (!wait()) {
+                return channel_status::kTimeout;
+            }
+            waiter_.reset();
+        }
+
+        return status;
+    }
+};
+
+}  // namespace msd
+
+#endif  // MSD_CHANNEL_SELECT_HPP_
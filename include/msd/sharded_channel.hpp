@@ -0,0 +1,438 @@
+// Copyright (C) 2020-2025 Andrei Avram
+
+#ifndef MSD_CHANNEL_SHARDED_CHANNEL_HPP_
+#define MSD_CHANNEL_SHARDED_CHANNEL_HPP_
+
+#include "blocking_iterator.hpp"
+#include "channel.hpp"
+#include "nodiscard.hpp"
+#include "parking.hpp"
+#include "status.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/** @file */
+
+namespace msd {
+
+namespace detail {
+
+/**
+ * @brief Returns a number identifying the current thread, assigned in the order threads first ask for it.
+ *
+ * @return The index of the current thread.
+ */
+inline std::size_t this_thread_index() noexcept
+{
+    static std::atomic<std::size_t> next{0};
+    static thread_local const std::size_t index = next.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Channel made of several msd::channel shards, for many writers and readers that would contend on one lock.
+ *
+ * - Each thread has a home shard. Writers push to their home shard, spilling over to the other shards if it is full.
+ * - Readers take from their home shard first and steal from the other shards when it is empty.
+ * - Elements written by the same thread to the same shard are read in order; there is no ordering across shards.
+ * - Readers that find all shards empty sleep in one place, woken up by writers only if someone is sleeping.
+ * - Not movable, not copyable.
+ * - Includes a blocking input iterator.
+ *
+ * @tparam T The type of the elements.
+ * @tparam Storage The storage type of each shard. Default: msd::queue_storage.
+ */
+template <typename T, typename Storage = default_storage<T>>
+class sharded_channel {
+   public:
+    static_assert(is_supported_type<T>::value, "Type T does not meet all requirements.");
+
+    /**
+     * @brief The type of elements stored in the channel.
+     */
+    using value_type = T;
+
+    /**
+     * @brief The iterator type used to traverse the channel.
+     */
+    using iterator = blocking_iterator<sharded_channel<T, Storage>>;
+
+    /**
+     * @brief The type used to represent sizes and counts.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Creates a channel with one unbuffered shard for each hardware thread.
+     */
+    sharded_channel() : sharded_channel{std::thread::hardware_concurrency()} {}
+
+    /**
+     * @brief Creates a channel with a given number of shards.
+     *
+     * @param shards Number of shards (at least one is created).
+     * @param shard_capacity Number of elements each shard can store before blocking (ignored for static storages).
+     */
+    explicit sharded_channel(const size_type shards, const size_type shard_capacity = 0)
+    {
+        const size_type count = shards > 0 ? shards : 1;
+        shards_.reserve(count);
+        for (size_type i = 0; i < count; ++i) {
+            shards_.push_back(make_shard(shard_capacity, is_static_storage<Storage>{}));
+        }
+    }
+
+    /**
+     * @brief Pushes an element into the channel.
+     *
+     * @param chan Channel to write to.
+     * @param value Value to write.
+     * @return Instance of channel.
+     * @throws closed_channel if channel is closed.
+     */
+    template <typename Type, typename Store>
+    friend sharded_channel<typename std::decay<Type>::type, Store>& operator<<(
+        sharded_channel<typename std::decay<Type>::type, Store>& chan, Type&& value);
+
+    /**
+     * @brief Pops an element from the channel.
+     *
+     * @param chan Channel to read from.
+     * @param out Where to write read value.
+     * @return Instance of channel.
+     */
+    template <typename Type, typename Store>
+    friend sharded_channel<Type, Store>& operator>>(sharded_channel<Type, Store>& chan, Type& out);
+
+    /**
+     * @brief Pushes an element into the home shard, or another shard with space, blocking if all shards are full.
+     *
+     * @tparam Type The type of the elements.
+     * @param value The element to be pushed into the channel.
+     * @return true If an element was successfully pushed into the channel.
+     * @return false If the channel is closed.
+     */
+    template <typename Type>
+    bool write(Type&& value)
+    {
+        const channel_status status = try_write(std::forward<Type>(value));
+        if (status != channel_status::kFull) {
+            return status == channel_status::kOk;
+        }
+
+        if (!home_shard().write(std::forward<Type>(value))) {
+            return false;
+        }
+
+        readers_.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Pushes an element into the home shard, or another shard with space, without waiting.
+     *
+     * @tparam Type The type of the elements.
+     * @param value The element to be pushed into the channel. Not moved from if all shards are full.
+     * @return channel_status::kOk If the element was pushed.
+     * @return channel_status::kFull If all shards are full.
+     * @return channel_status::kClosed If the channel is closed.
+     */
+    template <typename Type>
+    channel_status try_write(Type&& value)
+    {
+        const size_type home = home_index();
+        for (size_type i = 0; i < shards_.size(); ++i) {
+            const channel_status status = shard(home + i).try_write(std::forward<Type>(value));
+            if (status == channel_status::kOk) {
+                readers_.notify_one();
+            }
+            if (status != channel_status::kFull) {
+                return status;
+            }
+        }
+
+        return channel_status::kFull;
+    }
+
+    /**
+     * @brief Pushes an element into the channel, waiting for space in the home shard until a deadline.
+     *
+     * @tparam Type The type of the elements.
+     * @tparam Clock The clock of the deadline.
+     * @tparam Duration The duration type of the deadline.
+     * @param value The element to be pushed into the channel. Not moved from if not pushed.
+     * @param deadline Point in time after which to give up waiting.
+     * @return channel_status::kOk If the element was pushed.
+     * @return channel_status::kTimeout If all shards stayed full until the deadline.
+     * @return channel_status::kClosed If the channel is closed.
+     */
+    template <typename Type, typename Clock, typename Duration>
+    channel_status write_until(Type&& value, const std::chrono::time_point<Clock, Duration>& deadline)
+    {
+        channel_status status = try_write(std::forward<Type>(value));
+        if (status != channel_status::kFull) {
+            return status;
+        }
+
+        status = home_shard().write_until(std::forward<Type>(value), deadline);
+        if (status == channel_status::kOk) {
+            readers_.notify_one();
+        }
+
+        return status;
+    }
+
+    /**
+     * @brief Pushes an element into the channel, waiting for space in the home shard at most a given duration.
+     *
+     * @tparam Type The type of the elements.
+     * @tparam Rep The arithmetic type of the duration.
+     * @tparam Period The period of the duration.
+     * @param value The element to be pushed into the channel. Not moved from if not pushed.
+     * @param timeout Maximum duration to wait for.
+     * @return channel_status::kOk If the element was pushed.
+     * @return channel_status::kTimeout If all shards stayed full for the whole duration.
+     * @return channel_status::kClosed If the channel is closed.
+     */
+    template <typename Type, typename Rep, typename Period>
+    channel_status write_for(Type&& value, const std::chrono::duration<Rep, Period>& timeout)
+    {
+        return write_until(std::forward<Type>(value), std::chrono::steady_clock::now() + timeout);
+    }
+
+    /**
+     * @brief Pops an element from the home shard, or steals one from another shard, blocking if all are empty.
+     *
+     * @param out Reference to the variable where the popped element will be stored.
+     * @return true If an element was read.
+     * @return false If the channel is closed and all shards are empty.
+     */
+    bool read(T& out)
+    {
+        while (true) {
+            const channel_status status = try_read(out);
+            if (status != channel_status::kEmpty) {
+                return status == channel_status::kOk;
+            }
+
+            readers_.wait([this]() { return readable(); });
+        }
+    }
+
+    /**
+     * @brief Pops an element from the home shard, or steals one from another shard, without waiting.
+     *
+     * @param out Reference to the variable where the popped element will be stored.
+     * @return channel_status::kOk If an element was read.
+     * @return channel_status::kEmpty If all shards are empty.
+     * @return channel_status::kClosed If the channel is closed and all shards are empty.
+     */
+    channel_status try_read(T& out)
+    {
+        const size_type home = home_index();
+        bool all_closed = true;
+        for (size_type i = 0; i < shards_.size(); ++i) {
+            const channel_status status = shard(home + i).try_read(out);
+            if (status == channel_status::kOk) {
+                return status;
+            }
+            all_closed = all_closed && status == channel_status::kClosed;
+        }
+
+        return all_closed ? channel_status::kClosed : channel_status::kEmpty;
+    }
+
+    /**
+     * @brief Pops an element from the channel, waiting for one until a deadline.
+     *
+     * @tparam Clock The clock of the deadline.
+     * @tparam Duration The duration type of the deadline.
+     * @param out Reference to the variable where the popped element will be stored.
+     * @param deadline Point in time after which to give up waiting.
+     * @return channel_status::kOk If an element was read.
+     * @return channel_status::kTimeout If all shards stayed empty until the deadline.
+     * @return channel_status::kClosed If the channel is closed and all shards are empty.
+     */
+    template <typename Clock, typename Duration>
+    channel_status read_until(T& out, const std::chrono::time_point<Clock, Duration>& deadline)
+    {
+        while (true) {
+            const channel_status status = try_read(out);
+            if (status != channel_status::kEmpty) {
+                return status;
+            }
+
+            if (!readers_.wait_until(deadline, [this]() { return readable(); })) {
+                return channel_status::kTimeout;
+            }
+        }
+    }
+
+    /**
+     * @brief Pops an element from the channel, waiting for one at most a given duration.
+     *
+     * @tparam Rep The arithmetic type of the duration.
+     * @tparam Period The period of the duration.
+     * @param out Reference to the variable where the popped element will be stored.
+     * @param timeout Maximum duration to wait for.
+     * @return channel_status::kOk If an element was read.
+     * @return channel_status::kTimeout If all shards stayed empty for the whole duration.
+     * @return channel_status::kClosed If the channel is closed and all shards are empty.
+     */
+    template <typename Rep, typename Period>
+    channel_status read_for(T& out, const std::chrono::duration<Rep, Period>& timeout)
+    {
+        return read_until(out, std::chrono::steady_clock::now() + timeout);
+    }
+
+    /**
+     * @brief Returns the number of elements in all shards.
+     *
+     * @return The sum of the shard sizes, each taken at a different moment.
+     */
+    NODISCARD size_type size() const noexcept
+    {
+        size_type total = 0;
+        for (const auto& chan : shards_) {
+            total += chan->size();
+        }
+
+        return total;
+    }
+
+    /**
+     * @brief Checks if all shards are empty.
+     *
+     * @return true If no shard holds elements.
+     * @return false Otherwise.
+     */
+    NODISCARD bool empty() const noexcept
+    {
+        for (const auto& chan : shards_) {
+            if (!chan->empty()) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Returns the number of shards.
+     *
+     * @return Number of shards.
+     */
+    NODISCARD size_type shards() const noexcept { return shards_.size(); }
+
+    /**
+     * @brief Closes all shards and wakes up the sleeping readers.
+     */
+    void close() noexcept
+    {
+        closed_.store(true, std::memory_order_seq_cst);
+        for (auto& chan : shards_) {
+            chan->close();
+        }
+        readers_.notify_all();
+    }
+
+    /**
+     * @brief Checks if the channel has been closed.
+     *
+     * @return true If no more elements can be added to the channel.
+     * @return false Otherwise.
+     */
+    NODISCARD bool closed() const noexcept { return closed_.load(std::memory_order_seq_cst); }
+
+    /**
+     * @brief Checks if the channel has been closed and all shards are empty.
+     *
+     * @return true If nothing can be read anymore.
+     * @return false Otherwise.
+     */
+    NODISCARD bool drained() const noexcept { return closed() && empty(); }
+
+    /**
+     * @brief Returns an iterator to the beginning of the channel.
+     *
+     * @return A blocking iterator pointing to the start of the channel.
+     */
+    iterator begin() noexcept { return blocking_iterator<sharded_channel<T, Storage>>{*this}; }
+
+    /**
+     * @brief Returns an iterator representing the end of the channel.
+     *
+     * @return A blocking iterator representing the end condition.
+     */
+    iterator end() noexcept { return blocking_iterator<sharded_channel<T, Storage>>{*this, true}; }
+
+    sharded_channel(const sharded_channel&) = delete;
+    sharded_channel& operator=(const sharded_channel&) = delete;
+    sharded_channel(sharded_channel&&) = delete;
+    sharded_channel& operator=(sharded_channel&&) = delete;
+    virtual ~sharded_channel() = default;
+
+   private:
+    using shard_type = channel<T, Storage>;
+
+    // Shards are allocated separately, so their locks do not share a cache line.
+    std::vector<std::unique_ptr<shard_type>> shards_;
+    std::atomic<bool> closed_{false};
+    detail::parking readers_;
+
+    static std::unique_ptr<shard_type> make_shard(size_type, std::true_type)
+    {
+        return std::unique_ptr<shard_type>{new shard_type{}};
+    }
+
+    static std::unique_ptr<shard_type> make_shard(const size_type capacity, std::false_type)
+    {
+        return std::unique_ptr<shard_type>{new shard_type{capacity}};
+    }
+
+    size_type home_index() const noexcept { return detail::this_thread_index() % shards_.size(); }
+
+    shard_type& shard(const size_type index) noexcept { return *shards_[index % shards_.size()]; }
+
+    shard_type& home_shard() noexcept { return *shards_[home_index()]; }
+
+    // Called while parked: a writer publishes elements under the shard lock before checking for sleeping readers.
+    bool readable() const noexcept { return closed() || !empty(); }
+};
+
+/**
+ * @copydoc msd::sharded_channel::operator<<
+ */
+template <typename T, typename Storage>
+sharded_channel<typename std::decay<T>::type, Storage>& operator<<(
+    sharded_channel<typename std::decay<T>::type, Storage>& chan, T&& value)
+{
+    if (!chan.write(std::forward<T>(value))) {
+        throw closed_channel{"cannot write on closed channel"};
+    }
+
+    return chan;
+}
+
+/**
+ * @copydoc msd::sharded_channel::operator>>
+ */
+template <typename T, typename Storage>
+sharded_channel<T, Storage>& operator>>(sharded_channel<T, Storage>& chan, T& out)
+{
+    chan.read(out);
+
+    return chan;
+}
+
+}  // namespace msd
+
+#endif  // MSD_CHANNEL_SHARDED_CHANNEL_HPP_
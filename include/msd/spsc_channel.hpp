@@ -0,0 +1,590 @@
+// Copyright (C) 2020-2025 Andrei Avram
+
+#ifndef MSD_CHANNEL_SPSC_CHANNEL_HPP_
+#define MSD_CHANNEL_SPSC_CHANNEL_HPP_
+
+#include "blocking_iterator.hpp"
+#include "channel.hpp"
+#include "nodiscard.hpp"
+#include "parking.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+/** @file */
+
+namespace msd {
+
+/**
+ * @brief Contiguous slots of a channel, reserved by a writer to fill them or by a reader to read them in place.
+ *
+ * @tparam T The type of the elements.
+ */
+template <typename T>
+class slot_range {
+   public:
+    /**
+     * @brief Creates an empty range.
+     */
+    slot_range() = default;
+
+    /**
+     * @brief Creates a range of slots.
+     *
+     * @param first Pointer to the first slot.
+     * @param count Number of slots.
+     */
+    slot_range(T* first, const std::size_t count) noexcept : first_{first}, size_{count} {}
+
+    /**
+     * @brief Returns a pointer to the first slot.
+     *
+     * @return Pointer to the first slot.
+     */
+    T* begin() const noexcept { return first_; }
+
+    /**
+     * @brief Returns a pointer past the last slot.
+     *
+     * @return Pointer past the last slot.
+     */
+    T* end() const noexcept { return first_ + size_; }
+
+    /**
+     * @brief Returns a slot.
+     *
+     * @param index Position of the slot in the range.
+     * @return Reference to the slot.
+     */
+    T& operator[](const std::size_t index) const noexcept { return first_[index]; }
+
+    /**
+     * @brief Returns the number of slots.
+     *
+     * @return Number of slots.
+     */
+    NODISCARD std::size_t size() const noexcept { return size_; }
+
+    /**
+     * @brief Checks if the range has no slots (the channel is closed).
+     *
+     * @return true If there are no slots.
+     * @return false Otherwise.
+     */
+    NODISCARD bool empty() const noexcept { return size_ == 0; }
+
+   private:
+    T* first_{};
+    std::size_t size_{};
+};
+
+/**
+ * @brief Lock-free channel for exactly one writer thread and one reader thread.
+ *
+ * - Allocates elements inside the channel object (like msd::static_channel).
+ * - Uses atomic head/tail indices instead of a mutex; threads are parked only when the channel is empty/full.
+ * - Not movable, not copyable.
+ * - Includes a blocking input iterator.
+ * - Always buffered (with **Capacity**).
+ *
+ * @tparam T The type of the elements.
+ * @tparam Capacity The maximum number of elements the channel can hold before blocking. Must be greater than zero.
+ * @warning It's undefined behaviour to write from more than one thread or to read from more than one thread at the same
+ * time. Closing is allowed from any thread.
+ */
+template <typename T, std::size_t Capacity>
+class spsc_channel {
+   public:
+    static_assert(is_supported_type<T>::value, "Type T does not meet all requirements.");
+    static_assert(Capacity > 0, "Capacity must be greater than zero.");
+    static_assert(std::is_default_constructible<T>::value, "Type T must be default constructible.");
+
+    /**
+     * @brief The type of elements stored in the channel.
+     */
+    using value_type = T;
+
+    /**
+     * @brief The iterator type used to traverse the channel.
+     */
+    using iterator = blocking_iterator<spsc_channel<T, Capacity>>;
+
+    /**
+     * @brief The type used to represent sizes and counts.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Creates a buffered channel with **Capacity** elements.
+     */
+    spsc_channel() = default;
+
+    /**
+     * @brief Pushes an element into the channel.
+     *
+     * @param chan Channel to write to.
+     * @param value Value to write.
+     * @return Instance of channel.
+     * @throws closed_channel if channel is closed.
+     */
+    template <typename Type, std::size_t Cap>
+    friend spsc_channel<typename std::decay<Type>::type, Cap>& operator<<(
+        spsc_channel<typename std::decay<Type>::type, Cap>& chan, Type&& value);
+
+    /**
+     * @brief Pops an element from the channel.
+     *
+     * @param chan Channel to read from.
+     * @param out Where to write read value.
+     * @return Instance of channel.
+     */
+    template <typename Type, std::size_t Cap>
+    friend spsc_channel<Type, Cap>& operator>>(spsc_channel<Type, Cap>& chan, Type& out);
+
+    /**
+     * @brief Pushes an element into the channel, blocking while the channel is full.
+     *
+     * @tparam Type The type of the elements.
+     * @param value The element to be pushed into the channel.
+     * @return true If an element was successfully pushed into the channel.
+     * @return false If the channel is closed.
+     */
+    template <typename Type>
+    bool write(Type&& value)
+    {
+        while (true) {
+            const channel_status status = try_write(std::forward<Type>(value));
+            if (status != channel_status::kFull) {
+                return status == channel_status::kOk;
+            }
+
+            writers_.wait([this]() { return can_write(); });
+        }
+    }
+
+    /**
+     * @brief Pushes an element into the channel if there is space, without waiting.
+     *
+     * @tparam Type The type of the elements.
+     * @param value The element to be pushed into the channel. Not moved from if the channel is full.
+     * @return channel_status::kOk If the element was pushed.
+     * @return channel_status::kFull If the channel is full.
+     * @return channel_status::kClosed If the channel is closed.
+     */
+    template <typename Type>
+    channel_status try_write(Type&& value)
+    {
+        const size_type tail = tail_;
+
+        if (closed()) {
+            return channel_status::kClosed;
+        }
+
+        if (tail - cached_head_ >= Capacity) {
+            cached_head_ = head_index_.load(std::memory_order_acquire);
+            if (tail - cached_head_ >= Capacity) {
+                return channel_status::kFull;
+            }
+        }
+
+        buffer_[tail % Capacity] = std::forward<Type>(value);
+
+        // Publishing fails if the channel was closed meanwhile, so no element is ever written after close().
+        size_type expected = tail;
+        if (!tail_index_.compare_exchange_strong(expected, tail + 1, std::memory_order_release,
+                                                 std::memory_order_relaxed)) {
+            return channel_status::kClosed;
+        }
+        tail_ = tail + 1;
+
+        readers_.notify_all();
+
+        return channel_status::kOk;
+    }
+
+    /**
+     * @brief Pushes an element into the channel, waiting for space until a deadline.
+     *
+     * @tparam Type The type of the elements.
+     * @tparam Clock The clock of the deadline.
+     * @tparam Duration The duration type of the deadline.
+     * @param value The element to be pushed into the channel. Not moved from if the channel is full.
+     * @param deadline Point in time after which to give up waiting.
+     * @return channel_status::kOk If the element was pushed.
+     * @return channel_status::kTimeout If the channel was full until the deadline.
+     * @return channel_status::kClosed If the channel is closed.
+     */
+    template <typename Type, typename Clock, typename Duration>
+    channel_status write_until(Type&& value, const std::chrono::time_point<Clock, Duration>& deadline)
+    {
+        while (true) {
+            const channel_status status = try_write(std::forward<Type>(value));
+            if (status != channel_status::kFull) {
+                return status;
+            }
+
+            if (!writers_.wait_until(deadline, [this]() { return can_write(); })) {
+                return channel_status::kTimeout;
+            }
+        }
+    }
+
+    /**
+     * @brief Pushes an element into the channel, waiting for space at most a given duration.
+     *
+     * @tparam Type The type of the elements.
+     * @tparam Rep The arithmetic type of the duration.
+     * @tparam Period The period of the duration.
+     * @param value The element to be pushed into the channel. Not moved from if the channel is full.
+     * @param timeout Maximum duration to wait for.
+     * @return channel_status::kOk If the element was pushed.
+     * @return channel_status::kTimeout If the channel was full for the whole duration.
+     * @return channel_status::kClosed If the channel is closed.
+     */
+    template <typename Type, typename Rep, typename Period>
+    channel_status write_for(Type&& value, const std::chrono::duration<Rep, Period>& timeout)
+    {
+        return write_until(std::forward<Type>(value), std::chrono::steady_clock::now() + timeout);
+    }
+
+    /**
+     * @brief Pops an element from the channel, blocking while the channel is empty.
+     *
+     * @param out Reference to the variable where the popped element will be stored.
+     * @return true If an element was successfully read from the channel.
+     * @return false If the channel is closed and empty.
+     */
+    bool read(T& out)
+    {
+        while (true) {
+            const channel_status status = try_read(out);
+            if (status != channel_status::kEmpty) {
+                return status == channel_status::kOk;
+            }
+
+            readers_.wait([this]() { return can_read(); });
+        }
+    }
+
+    /**
+     * @brief Pops an element from the channel if there is one, without waiting.
+     *
+     * @param out Reference to the variable where the popped element will be stored.
+     * @return channel_status::kOk If an element was read.
+     * @return channel_status::kEmpty If the channel is empty.
+     * @return channel_status::kClosed If the channel is closed and empty.
+     */
+    channel_status try_read(T& out)
+    {
+        const size_type head = head_;
+
+        if (head == cached_tail_) {
+            const size_type tail = tail_index_.load(std::memory_order_acquire);
+            cached_tail_ = index(tail);
+
+            if (cached_tail_ == head) {
+                return is_closed(tail) ? channel_status::kClosed : channel_status::kEmpty;
+            }
+        }
+
+        out = std::move(buffer_[head % Capacity]);
+        head_index_.store(head + 1, std::memory_order_release);
+        head_ = head + 1;
+
+        writers_.notify_all();
+
+        return channel_status::kOk;
+    }
+
+    /**
+     * @brief Pops an element from the channel, waiting for one until a deadline.
+     *
+     * @tparam Clock The clock of the deadline.
+     * @tparam Duration The duration type of the deadline.
+     * @param out Reference to the variable where the popped element will be stored.
+     * @param deadline Point in time after which to give up waiting.
+     * @return channel_status::kOk If an element was read.
+     * @return channel_status::kTimeout If the channel was empty until the deadline.
+     * @return channel_status::kClosed If the channel is closed and empty.
+     */
+    template <typename Clock, typename Duration>
+    channel_status read_until(T& out, const std::chrono::time_point<Clock, Duration>& deadline)
+    {
+        while (true) {
+            const channel_status status = try_read(out);
+            if (status != channel_status::kEmpty) {
+                return status;
+            }
+
+            if (!readers_.wait_until(deadline, [this]() { return can_read(); })) {
+                return channel_status::kTimeout;
+            }
+        }
+    }
+
+    /**
+     * @brief Pops an element from the channel, waiting for one at most a given duration.
+     *
+     * @tparam Rep The arithmetic type of the duration.
+     * @tparam Period The period of the duration.
+     * @param out Reference to the variable where the popped element will be stored.
+     * @param timeout Maximum duration to wait for.
+     * @return channel_status::kOk If an element was read.
+     * @return channel_status::kTimeout If the channel was empty for the whole duration.
+     * @return channel_status::kClosed If the channel is closed and empty.
+     */
+    template <typename Rep, typename Period>
+    channel_status read_for(T& out, const std::chrono::duration<Rep, Period>& timeout)
+    {
+        return read_until(out, std::chrono::steady_clock::now() + timeout);
+    }
+
+    /**
+     * @brief Reserves free slots for the writer to fill in place, blocking while the channel is full.
+     *
+     * @details The slots hold elements previously read from the channel (or default constructed ones); assign them and
+     * publish them with commit(). Returns only slots contiguous in memory, so fewer than **count** may be returned even
+     * if there is more free space.
+     *
+     * @param count Maximum number of slots to reserve.
+     * @return The reserved slots, empty only if the channel is closed (or if **count** is 0).
+     * @warning Writer side only: it's undefined behaviour to call write functions between claim() and commit().
+     */
+    slot_range<T> claim(const size_type count = Capacity)
+    {
+        while (count > 0 && !closed()) {
+            if (tail_ - cached_head_ >= Capacity) {
+                cached_head_ = head_index_.load(std::memory_order_acquire);
+            }
+
+            const size_type free = Capacity - (tail_ - cached_head_);
+            if (free > 0) {
+                const size_type offset = tail_ % Capacity;
+                return slot_range<T>{&buffer_[offset], std::min(std::min(free, Capacity - offset), count)};
+            }
+
+            writers_.wait([this]() { return can_write(); });
+        }
+
+        return slot_range<T>{};
+    }
+
+    /**
+     * @brief Publishes the first **count** slots returned by claim() to the reader.
+     *
+     * @param count Number of filled slots, at most the size of the claimed range.
+     * @return true If the elements were published.
+     * @return false If the channel was closed meanwhile (the elements are discarded).
+     */
+    bool commit(const size_type count)
+    {
+        const size_type tail = tail_;
+
+        size_type expected = tail;
+        if (!tail_index_.compare_exchange_strong(expected, tail + count, std::memory_order_release,
+                                                 std::memory_order_relaxed)) {
+            return false;
+        }
+        tail_ = tail + count;
+
+        readers_.notify_all();
+
+        return true;
+    }
+
+    /**
+     * @brief Gives the reader access to ready elements in place, blocking while the channel is empty.
+     *
+     * @details The elements stay in the channel until they are given back with release(). Returns only elements
+     * contiguous in memory, so fewer than **count** may be returned even if more are ready.
+     *
+     * @param count Maximum number of elements to access.
+     * @return The ready elements, empty only if the channel is closed and empty (or if **count** is 0).
+     * @warning Reader side only: it's undefined behaviour to call read functions between acquire() and release().
+     */
+    slot_range<T> acquire(const size_type count = Capacity)
+    {
+        while (count > 0) {
+            bool drained{};
+            if (head_ == cached_tail_) {
+                const size_type tail = tail_index_.load(std::memory_order_acquire);
+                cached_tail_ = index(tail);
+                drained = is_closed(tail) && cached_tail_ == head_;
+            }
+
+            const size_type ready = cached_tail_ - head_;
+            if (ready > 0) {
+                const size_type offset = head_ % Capacity;
+                return slot_range<T>{&buffer_[offset], std::min(std::min(ready, Capacity - offset), count)};
+            }
+
+            if (drained) {
+                return slot_range<T>{};
+            }
+
+            readers_.wait([this]() { return can_read(); });
+        }
+
+        return slot_range<T>{};
+    }
+
+    /**
+     * @brief Frees the first **count** elements returned by acquire(), making room for the writer.
+     *
+     * @param count Number of elements done with, at most the size of the acquired range.
+     */
+    void release(const size_type count)
+    {
+        head_ += count;
+        head_index_.store(head_, std::memory_order_release);
+
+        writers_.notify_all();
+    }
+
+    /**
+     * @brief Returns the current size of the channel.
+     *
+     * @return The number of elements in the channel.
+     */
+    NODISCARD size_type size() const noexcept
+    {
+        const size_type head = head_index_.load(std::memory_order_acquire);
+        return index(tail_index_.load(std::memory_order_acquire)) - head;
+    }
+
+    /**
+     * @brief Checks if the channel is empty.
+     *
+     * @return true If the channel contains no elements.
+     * @return false Otherwise.
+     */
+    NODISCARD bool empty() const noexcept { return size() == 0; }
+
+    /**
+     * @brief Closes the channel, no longer accepting new elements.
+     */
+    void close() noexcept
+    {
+        tail_index_.fetch_or(closed_flag, std::memory_order_acq_rel);
+        readers_.notify_all();
+        writers_.notify_all();
+    }
+
+    /**
+     * @brief Checks if the channel has been closed.
+     *
+     * @return true If no more elements can be added to the channel.
+     * @return false Otherwise.
+     */
+    NODISCARD bool closed() const noexcept { return is_closed(tail_index_.load(std::memory_order_acquire)); }
+
+    /**
+     * @brief Checks if the channel has been closed and is empty.
+     *
+     * @return true If nothing can be read anymore from the channel.
+     * @return false Otherwise.
+     */
+    NODISCARD bool drained() noexcept
+    {
+        const size_type tail = tail_index_.load(std::memory_order_acquire);
+        return is_closed(tail) && index(tail) == head_index_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Returns an iterator to the beginning of the channel.
+     *
+     * @return A blocking iterator pointing to the start of the channel.
+     */
+    iterator begin() noexcept { return blocking_iterator<spsc_channel<T, Capacity>>{*this}; }
+
+    /**
+     * @brief Returns an iterator representing the end of the channel.
+     *
+     * @return A blocking iterator representing the end condition.
+     */
+    iterator end() noexcept { return blocking_iterator<spsc_channel<T, Capacity>>{*this, true}; }
+
+    spsc_channel(const spsc_channel&) = delete;
+    spsc_channel& operator=(const spsc_channel&) = delete;
+    spsc_channel(spsc_channel&&) = delete;
+    spsc_channel& operator=(spsc_channel&&) = delete;
+    virtual ~spsc_channel() = default;
+
+   private:
+    // The closed state lives in the highest bit of the tail index, so closing and publishing an element cannot race.
+    static constexpr size_type closed_flag = size_type{1} << (std::numeric_limits<size_type>::digits - 1);
+
+    // Written by the reader.
+    std::atomic<size_type> head_index_{0};
+    char head_padding_[detail::cache_line_size - sizeof(std::atomic<size_type>)]{};
+
+    // Written by the writer (and by close).
+    std::atomic<size_type> tail_index_{0};
+    char tail_padding_[detail::cache_line_size - sizeof(std::atomic<size_type>)]{};
+
+    // Reader's own copies of the indices, to avoid touching the writer's cache line on every read.
+    size_type head_{0};
+    size_type cached_tail_{0};
+    char reader_padding_[detail::cache_line_size - (2 * sizeof(size_type))]{};
+
+    // Writer's own copies of the indices.
+    size_type tail_{0};
+    size_type cached_head_{0};
+    char writer_padding_[detail::cache_line_size - (2 * sizeof(size_type))]{};
+
+    detail::parking readers_;
+    detail::parking writers_;
+    std::array<T, Capacity> buffer_{};
+
+    static constexpr bool is_closed(const size_type tail) noexcept { return (tail & closed_flag) != 0; }
+
+    static constexpr size_type index(const size_type tail) noexcept { return tail & ~closed_flag; }
+
+    bool can_write() const noexcept
+    {
+        return tail_ - head_index_.load(std::memory_order_acquire) < Capacity || closed();
+    }
+
+    bool can_read() const noexcept
+    {
+        const size_type tail = tail_index_.load(std::memory_order_acquire);
+        return index(tail) != head_ || is_closed(tail);
+    }
+};
+
+template <typename T, std::size_t Capacity>
+constexpr typename spsc_channel<T, Capacity>::size_type spsc_channel<T, Capacity>::closed_flag;
+
+/**
+ * @copydoc msd::spsc_channel::operator<<
+ */
+template <typename T, std::size_t Capacity>
+spsc_channel<typename std::decay<T>::type, Capacity>& operator<<(
+    spsc_channel<typename std::decay<T>::type, Capacity>& chan, T&& value)
+{
+    if (!chan.write(std::forward<T>(value))) {
+        throw closed_channel{"cannot write on closed channel"};
+    }
+
+    return chan;
+}
+
+/**
+ * @copydoc msd::spsc_channel::operator>>
+ */
+template <typename T, std::size_t Capacity>
+spsc_channel<T, Capacity>& operator>>(spsc_channel<T, Capacity>& chan, T& out)
+{
+    chan.read(out);
+
+    return chan;
+}
+
+}  // namespace msd
+
+#endif  // MSD_CHANNEL_SPSC_CHANNEL_HPP_
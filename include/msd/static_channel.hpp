@@ -4,7 +4,9 @@
 #define MSD_CHANNEL_STATIC_CHANNEL_HPP_
 
 #include "channel.hpp"
+#include "statistics.hpp"
 #include "storage.hpp"
+#include "wait_strategy.hpp"
 
 #include <cstdlib>
 
@@ -23,9 +25,11 @@ namespace msd {
  *
  * @tparam T The type of the elements.
  * @tparam Capacity The maximum number of elements the channel can hold before blocking. Must be greater than zero.
+ * @tparam WaitStrategy What to do before parking a thread that cannot make progress. Default: msd::blocking_wait.
+ * @tparam Statistics What to record about the operations. Default: msd::no_statistics.
  */
-template <typename T, std::size_t Capacity>
-using static_channel = channel<T, array_storage<T, Capacity>>;
+template <typename T, std::size_t Capacity, typename WaitStrategy = blocking_wait, typename Statistics = no_statistics>
+using static_channel = channel<T, array_storage<T, Capacity>, WaitStrategy, Statistics>;
 
 }  // namespace msd
 
@@ -0,0 +1,209 @@
+// Copyright (C) 2020-2025 Andrei Avram
+
+#ifndef MSD_CHANNEL_STATISTICS_HPP_
+#define MSD_CHANNEL_STATISTICS_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+/** @file */
+
+namespace msd {
+
+/**
+ * @brief Statistics policy that records nothing (default of msd::channel).
+ *
+ * @details A statistics policy is an empty-base of the channel, notified with the channel locked. It must provide:
+ * - **time_point** and a static **now** function, called before waiting, whose result is passed back after waiting.
+ * - **acquire**, locking the channel mutex for an operation.
+ * - **on_write** and **on_read**, called after elements are pushed or popped.
+ * - **on_write_blocked** and **on_read_blocked**, called after a writer or reader had to wait.
+ *
+ * Optionally, a **snapshot_type** and a **snapshot** function, enabling msd::channel::statistics().
+ *
+ * This policy is empty and all its functions do nothing, so it adds no size and no code to the channel.
+ */
+struct no_statistics {
+    /**
+     * @brief Nothing is measured.
+     */
+    struct time_point {};
+
+    /**
+     * @brief Does not read any clock.
+     *
+     * @return An empty time point.
+     */
+    static constexpr time_point now() noexcept { return time_point{}; }
+
+    /**
+     * @brief Locks the mutex.
+     *
+     * @param lock Lock over the channel mutex, not locked.
+     */
+    static void acquire(std::unique_lock<std::mutex>& lock) { lock.lock(); }
+
+    /**
+     * @brief Does nothing.
+     */
+    static void on_write(std::size_t, std::size_t) noexcept {}
+
+    /**
+     * @brief Does nothing.
+     */
+    static void on_read(std::size_t) noexcept {}
+
+    /**
+     * @brief Does nothing.
+     */
+    static void on_write_blocked(time_point) noexcept {}
+
+    /**
+     * @brief Does nothing.
+     */
+    static void on_read_blocked(time_point) noexcept {}
+};
+
+/**
+ * @brief Counters of a channel, returned by msd::channel::statistics().
+ */
+struct channel_statistics_snapshot {
+    /**
+     * @brief Number of elements pushed.
+     */
+    std::uint64_t writes{};
+
+    /**
+     * @brief Number of elements popped.
+     */
+    std::uint64_t reads{};
+
+    /**
+     * @brief Number of times a writer waited because the channel was full.
+     */
+    std::uint64_t blocked_writes{};
+
+    /**
+     * @brief Number of times a reader waited because the channel was empty.
+     */
+    std::uint64_t blocked_reads{};
+
+    /**
+     * @brief Total time writers spent waiting for space.
+     */
+    std::chrono::nanoseconds write_blocked_time{};
+
+    /**
+     * @brief Total time readers spent waiting for elements.
+     */
+    std::chrono::nanoseconds read_blocked_time{};
+
+    /**
+     * @brief Largest number of elements the channel held at once.
+     */
+    std::size_t high_water_mark{};
+
+    /**
+     * @brief Number of operations that found the channel locked by another thread.
+     */
+    std::uint64_t contended_locks{};
+};
+
+/**
+ * @brief Statistics policy counting throughput, blocked time, peak occupancy and lock contention.
+ *
+ * @details `msd::channel<int, msd::queue_storage<int>, msd::blocking_wait, msd::channel_statistics> chan{10};`, then
+ * `chan.statistics()` returns a msd::channel_statistics_snapshot. The counters are plain integers updated with the
+ * channel locked. Each operation first tries to lock the channel without waiting, to count contention.
+ */
+class channel_statistics {
+   public:
+    /**
+     * @brief The type of the counters returned by snapshot().
+     */
+    using snapshot_type = channel_statistics_snapshot;
+
+    /**
+     * @brief Point in time when a thread started waiting.
+     */
+    using time_point = std::chrono::steady_clock::time_point;
+
+    /**
+     * @brief Returns the current time.
+     *
+     * @return The current time of the steady clock.
+     */
+    static time_point now() noexcept { return std::chrono::steady_clock::now(); }
+
+    /**
+     * @brief Locks the mutex, counting if it was locked by another thread.
+     *
+     * @param lock Lock over the channel mutex, not locked.
+     */
+    void acquire(std::unique_lock<std::mutex>& lock)
+    {
+        if (!lock.try_lock()) {
+            lock.lock();
+            ++counters_.contended_locks;
+        }
+    }
+
+    /**
+     * @brief Counts pushed elements.
+     *
+     * @param count Number of elements pushed.
+     * @param size Number of elements in the channel after pushing.
+     */
+    void on_write(const std::size_t count, const std::size_t size) noexcept
+    {
+        counters_.writes += count;
+        if (size > counters_.high_water_mark) {
+            counters_.high_water_mark = size;
+        }
+    }
+
+    /**
+     * @brief Counts popped elements.
+     *
+     * @param count Number of elements popped.
+     */
+    void on_read(const std::size_t count) noexcept { counters_.reads += count; }
+
+    /**
+     * @brief Counts a writer that waited for space.
+     *
+     * @param start When the writer started waiting.
+     */
+    void on_write_blocked(const time_point start) noexcept
+    {
+        ++counters_.blocked_writes;
+        counters_.write_blocked_time += std::chrono::duration_cast<std::chrono::nanoseconds>(now() - start);
+    }
+
+    /**
+     * @brief Counts a reader that waited for elements.
+     *
+     * @param start When the reader started waiting.
+     */
+    void on_read_blocked(const time_point start) noexcept
+    {
+        ++counters_.blocked_reads;
+        counters_.read_blocked_time += std::chrono::duration_cast<std::chrono::nanoseconds>(now() - start);
+    }
+
+    /**
+     * @brief Returns the counters.
+     *
+     * @return A copy of the counters.
+     */
+    snapshot_type snapshot() const noexcept { return counters_; }
+
+   private:
+    snapshot_type counters_{};
+};
+
+}  // namespace msd
+
+#endif  // MSD_CHANNEL_STATISTICS_HPP_
@@ -0,0 +1,42 @@
+// Copyright (C) 2020-2025 Andrei Avram
+
+#ifndef MSD_CHANNEL_STATUS_HPP_
+#define MSD_CHANNEL_STATUS_HPP_
+
+/** @file */
+
+namespace msd {
+
+/**
+ * @brief Result of a channel operation that does not block, or blocks until a deadline.
+ */
+enum class channel_status {
+    /**
+     * @brief The element was written or read.
+     */
+    kOk,
+
+    /**
+     * @brief Nothing to read: the channel is empty, but not closed.
+     */
+    kEmpty,
+
+    /**
+     * @brief No space to write: the channel is full.
+     */
+    kFull,
+
+    /**
+     * @brief The channel is closed (for reading: closed and empty).
+     */
+    kClosed,
+
+    /**
+     * @brief The deadline passed before the element could be written or read.
+     */
+    kTimeout,
+};
+
+}  // namespace msd
+
+#endif  // MSD_CHANNEL_STATUS_HPP_
@@ -3,13 +3,30 @@
 #ifndef MSD_CHANNEL_STORAGE_HPP_
 #define MSD_CHANNEL_STORAGE_HPP_
 
+#include "latency.hpp"
 #include "nodiscard.hpp"
 
+#include <algorithm>
 #include <array>
+#include <chrono>
+#include <cstdint>
 #include <cstdlib>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <new>
 #include <queue>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#if (__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)) && defined(__has_include)
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#define MSD_CHANNEL_HAS_PMR
+#endif
+#endif
+
 /** @file */
 
 namespace msd {
@@ -18,16 +35,23 @@ namespace msd {
  * @brief A FIFO queue storage using std::queue.
  *
  * @tparam T Type of elements stored.
+ * @tparam Allocator Allocator of the elements.
  */
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class queue_storage {
    public:
     /**
-     * @brief Constructs the queue storage (parameter ignored, required for interface compatibility).
+     * @brief The allocator of the elements.
+     */
+    using allocator_type = Allocator;
+
+    /**
+     * @brief Constructs the queue storage (capacity ignored, required for interface compatibility).
      *
+     * @param allocator Allocator of the elements.
      * @warning Do not construct manually. This constructor may change anytime.
      */
-    explicit queue_storage(std::size_t) {}
+    explicit queue_storage(std::size_t, const Allocator& allocator = Allocator()) : queue_{allocator} {}
 
     /**
      * @brief Adds an element to the back of the queue.
@@ -41,6 +65,18 @@ class queue_storage {
         queue_.push(std::forward<Type>(value));
     }
 
+    /**
+     * @brief Constructs an element in place at the back of the queue.
+     *
+     * @tparam Args Types of the arguments of the element's constructor.
+     * @param args The arguments of the element's constructor (perfect forwarded).
+     */
+    template <typename... Args>
+    void emplace_back(Args&&... args)
+    {
+        queue_.emplace(std::forward<Args>(args)...);
+    }
+
     /**
      * @brief Removes the front element from the queue and moves it to the output.
      *
@@ -53,6 +89,24 @@ class queue_storage {
         queue_.pop();
     }
 
+    /**
+     * @brief Returns the front element.
+     *
+     * @return Reference to the front element.
+     * @warning It's undefined behaviour to access the front of an empty queue.
+     */
+    T& front() noexcept { return queue_.front(); }
+
+    /**
+     * @brief Removes the front element.
+     *
+     * @warning It's undefined behaviour to pop from an empty queue.
+     */
+    void pop_front()
+    {
+        queue_.pop();
+    }
+
     /**
      * @brief Returns the number of elements currently stored.
      *
@@ -61,25 +115,35 @@ class queue_storage {
     NODISCARD std::size_t size() const noexcept { return queue_.size(); }
 
    private:
-    std::queue<T> queue_;
+    std::queue<T, std::deque<T, Allocator>> queue_;
 };
 
 /**
  * @brief A FIFO queue storage using std::vector.
  *
  * @tparam T Type of elements stored.
+ * @tparam Allocator Allocator of the elements.
  */
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class vector_storage {
    public:
+    /**
+     * @brief The allocator of the elements.
+     */
+    using allocator_type = Allocator;
+
     /**
      * @brief Constructs a queue storage with a given capacity.
      *
      * @param capacity Maximum number of elements the storage can hold.
+     * @param allocator Allocator of the elements.
      * @note Reserves the memory in advance.
      * @warning Do not construct manually. This constructor may change anytime.
      */
-    explicit vector_storage(std::size_t capacity) { vector_.reserve(capacity); }
+    explicit vector_storage(std::size_t capacity, const Allocator& allocator = Allocator()) : vector_{allocator}
+    {
+        vector_.reserve(capacity);
+    }
 
     /**
      * @brief Adds an element to the back of the vector.
@@ -93,6 +157,18 @@ class vector_storage {
         vector_.push_back(std::forward<Type>(value));
     }
 
+    /**
+     * @brief Constructs an element in place at the back of the vector.
+     *
+     * @tparam Args Types of the arguments of the element's constructor.
+     * @param args The arguments of the element's constructor (perfect forwarded).
+     */
+    template <typename... Args>
+    void emplace_back(Args&&... args)
+    {
+        vector_.emplace_back(std::forward<Args>(args)...);
+    }
+
     /**
      * @brief Removes the front element from the vector and moves it to the output.
      *
@@ -105,6 +181,24 @@ class vector_storage {
         vector_.erase(vector_.begin());
     }
 
+    /**
+     * @brief Returns the front element.
+     *
+     * @return Reference to the front element.
+     * @warning It's undefined behaviour to access the front of an empty vector.
+     */
+    T& front() noexcept { return vector_.front(); }
+
+    /**
+     * @brief Removes the front element.
+     *
+     * @warning It's undefined behaviour to pop from an empty vector.
+     */
+    void pop_front()
+    {
+        vector_.erase(vector_.begin());
+    }
+
     /**
      * @brief Returns the number of elements currently stored.
      *
@@ -113,7 +207,7 @@ class vector_storage {
     NODISCARD std::size_t size() const noexcept { return vector_.size(); }
 
    private:
-    std::vector<T> vector_;
+    std::vector<T, Allocator> vector_;
 };
 
 /**
@@ -127,6 +221,7 @@ template <typename T, std::size_t N>
 class array_storage {
    public:
     static_assert(N > 0, "Capacity must be greater than zero.");
+    static_assert(std::is_default_constructible<T>::value, "Type T must be default constructible.");
 
     /**
      * @brief The storage capacity.
@@ -149,6 +244,21 @@ class array_storage {
         ++size_;
     }
 
+    /**
+     * @brief Constructs an element and moves it to the back of the array.
+     *
+     * @tparam Args Types of the arguments of the element's constructor.
+     * @param args The arguments of the element's constructor (perfect forwarded).
+     * @note The array elements always exist, so the new element is move assigned. Use msd::ring_storage to construct
+     * elements in place.
+     * @warning It's undefined behaviour to push into a full array.
+     */
+    template <typename... Args>
+    void emplace_back(Args&&... args)
+    {
+        push_back(T(std::forward<Args>(args)...));
+    }
+
     /**
      * @brief Marks the front element as removed and moves it to the output.
      *
@@ -162,6 +272,51 @@ class array_storage {
         --size_;
     }
 
+    /**
+     * @brief Returns the front element.
+     *
+     * @return Reference to the front element.
+     * @warning It's undefined behaviour to access the front of an empty array.
+     */
+    T& front() noexcept { return array_[front_]; }
+
+    /**
+     * @brief Removes the front element.
+     *
+     * @warning It's undefined behaviour to pop from an empty array.
+     */
+    void pop_front()
+    {
+        front_ = (front_ + 1) % N;
+        --size_;
+    }
+
+    /**
+     * @brief Returns a pointer to the front element, the first of front_contiguous() elements stored contiguously.
+     *
+     * @return Pointer to the front element.
+     */
+    T* front_data() noexcept { return &array_[front_]; }
+
+    /**
+     * @brief Returns the number of elements stored contiguously from the front (until the end of the array).
+     *
+     * @return Number of contiguous elements.
+     */
+    NODISCARD std::size_t front_contiguous() const noexcept { return size_ < N - front_ ? size_ : N - front_; }
+
+    /**
+     * @brief Removes elements from the front.
+     *
+     * @param count Number of elements to remove.
+     * @warning It's undefined behaviour to remove more elements than stored.
+     */
+    void pop_front_n(const std::size_t count)
+    {
+        front_ = (front_ + count) % N;
+        size_ -= count;
+    }
+
     /**
      * @brief Returns the number of elements currently stored.
      *
@@ -178,6 +333,1061 @@ class array_storage {
 template <typename T, std::size_t N>
 constexpr std::size_t array_storage<T, N>::capacity;
 
+namespace detail {
+
+/**
+ * @brief Returns the smallest power of two greater than or equal to a number.
+ *
+ * @param number The number to round up.
+ * @param power Power of two to start from.
+ * @return The power of two.
+ */
+constexpr std::size_t next_power_of_two(const std::size_t number, const std::size_t power = 1) noexcept
+{
+    return power >= number ? power : next_power_of_two(number, power * 2);
+}
+
+}  // namespace detail
+
+/**
+ * @brief A fixed-size circular buffer over uninitialized memory.
+ *
+ * @details Unlike msd::array_storage, elements are constructed in place when pushed and destroyed when popped, so the
+ * storage costs nothing to create and does not require **T** to be default constructible. The buffer size is rounded
+ * up to a power of two to replace the modulo with a mask: choose **N** a power of two to avoid unused slots.
+ *
+ * @note For elements owning heap memory (eg: std::string), msd::array_storage can be faster, as assigning into its
+ * existing elements reuses their allocations.
+ *
+ * @tparam T Type of elements stored.
+ * @tparam N Maximum number of elements (capacity).
+ * @warning Do not construct manually. The constructor may change anytime.
+ */
+template <typename T, std::size_t N>
+class ring_storage {
+   public:
+    static_assert(N > 0, "Capacity must be greater than zero.");
+
+    /**
+     * @brief The storage capacity.
+     *
+     * @attention Required for static storage.
+     */
+    static constexpr std::size_t capacity = N;
+
+    /**
+     * @brief Creates an empty storage without constructing any element.
+     */
+    ring_storage() = default;
+
+    /**
+     * @brief Constructs an element at the back of the buffer.
+     *
+     * @tparam Type Type of the element to insert.
+     * @param value The value to insert (perfect forwarded).
+     * @warning It's undefined behaviour to push into a full buffer.
+     */
+    template <typename Type>
+    void push_back(Type&& value)
+    {
+        emplace_back(std::forward<Type>(value));
+    }
+
+    /**
+     * @brief Constructs an element in place at the back of the buffer.
+     *
+     * @tparam Args Types of the arguments of the element's constructor.
+     * @param args The arguments of the element's constructor (perfect forwarded).
+     * @warning It's undefined behaviour to push into a full buffer.
+     */
+    template <typename... Args>
+    void emplace_back(Args&&... args)
+    {
+        ::new (static_cast<void*>(slot(front_ + size_))) T(std::forward<Args>(args)...);
+        ++size_;
+    }
+
+    /**
+     * @brief Moves the front element to the output and destroys it.
+     *
+     * @param out Reference to the variable where the front element will be moved.
+     * @warning It's undefined behaviour to pop from an empty buffer.
+     */
+    void pop_front(T& out)
+    {
+        T* front = slot(front_);
+        out = std::move(*front);
+        front->~T();
+        front_ = (front_ + 1) & mask;
+        --size_;
+    }
+
+    /**
+     * @brief Returns the front element.
+     *
+     * @return Reference to the front element.
+     * @warning It's undefined behaviour to access the front of an empty buffer.
+     */
+    T& front() noexcept { return *slot(front_); }
+
+    /**
+     * @brief Removes the front element.
+     *
+     * @warning It's undefined behaviour to pop from an empty buffer.
+     */
+    void pop_front()
+    {
+        slot(front_)->~T();
+        front_ = (front_ + 1) & mask;
+        --size_;
+    }
+
+    /**
+     * @brief Returns a pointer to the front element, the first of front_contiguous() elements stored contiguously.
+     *
+     * @return Pointer to the front element.
+     */
+    T* front_data() noexcept { return slot(front_); }
+
+    /**
+     * @brief Returns the number of elements stored contiguously from the front (until the end of the buffer).
+     *
+     * @return Number of contiguous elements.
+     */
+    NODISCARD std::size_t front_contiguous() const noexcept
+    {
+        return size_ < buffer_size - front_ ? size_ : buffer_size - front_;
+    }
+
+    /**
+     * @brief Removes elements from the front.
+     *
+     * @param count Number of elements to remove.
+     * @warning It's undefined behaviour to remove more elements than stored.
+     */
+    void pop_front_n(const std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i) {
+            pop_front();
+        }
+    }
+
+    /**
+     * @brief Returns the number of elements currently stored.
+     *
+     * @return Current size.
+     */
+    NODISCARD std::size_t size() const noexcept { return size_; }
+
+    ring_storage(const ring_storage&) = delete;
+    ring_storage& operator=(const ring_storage&) = delete;
+    ring_storage(ring_storage&&) = delete;
+    ring_storage& operator=(ring_storage&&) = delete;
+
+    /**
+     * @brief Destroys the elements left in the buffer.
+     */
+    ~ring_storage()
+    {
+        for (std::size_t i = 0; i < size_; ++i) {
+            slot(front_ + i)->~T();
+        }
+    }
+
+   private:
+    struct alignas(T) raw_slot {
+        unsigned char bytes[sizeof(T)];
+    };
+
+    static constexpr std::size_t buffer_size = detail::next_power_of_two(N);
+    static constexpr std::size_t mask = buffer_size - 1;
+
+    raw_slot buffer_[buffer_size];
+    std::size_t size_{0};
+    std::size_t front_{0};
+
+    T* slot(const std::size_t index) noexcept { return reinterpret_cast<T*>(&buffer_[index & mask]); }
+};
+
+template <typename T, std::size_t N>
+constexpr std::size_t ring_storage<T, N>::capacity;
+
+/**
+ * @brief A circular buffer allocated once on the heap, with a capacity given at runtime.
+ *
+ * @details Like msd::ring_storage, elements are constructed in place when pushed and destroyed when popped, giving O(1)
+ * push and pop over contiguous memory (unlike msd::vector_storage, which shifts all elements on pop). The buffer size
+ * is the capacity rounded up to a power of two. If the capacity is zero (unbuffered channel), the buffer starts small
+ * and doubles when full.
+ *
+ * @tparam T Type of elements stored.
+ * @tparam Allocator Allocator of the buffer, also used to construct and destroy the elements.
+ */
+template <typename T, typename Allocator = std::allocator<T>>
+class dynamic_ring_storage {
+   public:
+    /**
+     * @brief The allocator of the buffer.
+     */
+    using allocator_type = Allocator;
+
+    /**
+     * @brief Constructs the storage, allocating the buffer for a given capacity.
+     *
+     * @param capacity Maximum number of elements the storage can hold (0 means unlimited).
+     * @param allocator Allocator of the buffer.
+     * @warning Do not construct manually. This constructor may change anytime.
+     */
+    explicit dynamic_ring_storage(const std::size_t capacity, const Allocator& allocator = Allocator())
+        : allocator_{allocator},
+          buffer_size_{detail::next_power_of_two(capacity > 0 ? capacity : initial_buffer_size)},
+          buffer_{traits::allocate(allocator_, buffer_size_)}
+    {
+    }
+
+    /**
+     * @brief Constructs an element at the back of the buffer.
+     *
+     * @tparam Type Type of the element to insert.
+     * @param value The value to insert (perfect forwarded).
+     */
+    template <typename Type>
+    void push_back(Type&& value)
+    {
+        emplace_back(std::forward<Type>(value));
+    }
+
+    /**
+     * @brief Constructs an element in place at the back of the buffer.
+     *
+     * @tparam Args Types of the arguments of the element's constructor.
+     * @param args The arguments of the element's constructor (perfect forwarded).
+     */
+    template <typename... Args>
+    void emplace_back(Args&&... args)
+    {
+        if (size_ == buffer_size_) {
+            grow();
+        }
+
+        traits::construct(allocator_, slot(front_ + size_), std::forward<Args>(args)...);
+        ++size_;
+    }
+
+    /**
+     * @brief Moves the front element to the output and destroys it.
+     *
+     * @param out Reference to the variable where the front element will be moved.
+     * @warning It's undefined behaviour to pop from an empty buffer.
+     */
+    void pop_front(T& out)
+    {
+        T* front = slot(front_);
+        out = std::move(*front);
+        traits::destroy(allocator_, front);
+        front_ = (front_ + 1) & (buffer_size_ - 1);
+        --size_;
+    }
+
+    /**
+     * @brief Returns the front element.
+     *
+     * @return Reference to the front element.
+     * @warning It's undefined behaviour to access the front of an empty buffer.
+     */
+    T& front() noexcept { return *slot(front_); }
+
+    /**
+     * @brief Removes the front element.
+     *
+     * @warning It's undefined behaviour to pop from an empty buffer.
+     */
+    void pop_front()
+    {
+        traits::destroy(allocator_, slot(front_));
+        front_ = (front_ + 1) & (buffer_size_ - 1);
+        --size_;
+    }
+
+    /**
+     * @brief Returns a pointer to the front element, the first of front_contiguous() elements stored contiguously.
+     *
+     * @return Pointer to the front element.
+     */
+    T* front_data() noexcept { return slot(front_); }
+
+    /**
+     * @brief Returns the number of elements stored contiguously from the front (until the end of the buffer).
+     *
+     * @return Number of contiguous elements.
+     */
+    NODISCARD std::size_t front_contiguous() const noexcept
+    {
+        return size_ < buffer_size_ - front_ ? size_ : buffer_size_ - front_;
+    }
+
+    /**
+     * @brief Removes elements from the front.
+     *
+     * @param count Number of elements to remove.
+     * @warning It's undefined behaviour to remove more elements than stored.
+     */
+    void pop_front_n(const std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i) {
+            pop_front();
+        }
+    }
+
+    /**
+     * @brief Returns the number of elements currently stored.
+     *
+     * @return Current size.
+     */
+    NODISCARD std::size_t size() const noexcept { return size_; }
+
+    dynamic_ring_storage(const dynamic_ring_storage&) = delete;
+    dynamic_ring_storage& operator=(const dynamic_ring_storage&) = delete;
+    dynamic_ring_storage(dynamic_ring_storage&&) = delete;
+    dynamic_ring_storage& operator=(dynamic_ring_storage&&) = delete;
+
+    /**
+     * @brief Destroys the elements left in the buffer and releases the buffer.
+     */
+    ~dynamic_ring_storage()
+    {
+        for (std::size_t i = 0; i < size_; ++i) {
+            traits::destroy(allocator_, slot(front_ + i));
+        }
+        traits::deallocate(allocator_, buffer_, buffer_size_);
+    }
+
+   private:
+    using traits = std::allocator_traits<Allocator>;
+
+    static constexpr std::size_t initial_buffer_size = 16;
+
+    Allocator allocator_;
+    std::size_t buffer_size_;
+    T* buffer_;
+    std::size_t size_{0};
+    std::size_t front_{0};
+
+    T* slot(const std::size_t index) const noexcept { return buffer_ + (index & (buffer_size_ - 1)); }
+
+    // Only for unlimited capacity: moves the elements to the front of a buffer twice as large.
+    void grow()
+    {
+        const std::size_t new_size = buffer_size_ * 2;
+        T* const new_buffer = traits::allocate(allocator_, new_size);
+
+        std::size_t moved = 0;
+        try {
+            for (; moved < size_; ++moved) {
+                traits::construct(allocator_, new_buffer + moved, std::move_if_noexcept(*slot(front_ + moved)));
+            }
+        }
+        catch (...) {
+            for (std::size_t i = 0; i < moved; ++i) {
+                traits::destroy(allocator_, new_buffer + i);
+            }
+            traits::deallocate(allocator_, new_buffer, new_size);
+            throw;
+        }
+
+        for (std::size_t i = 0; i < size_; ++i) {
+            traits::destroy(allocator_, slot(front_ + i));
+        }
+        traits::deallocate(allocator_, buffer_, buffer_size_);
+
+        buffer_ = new_buffer;
+        buffer_size_ = new_size;
+        front_ = 0;
+    }
+};
+
+template <typename T, typename Allocator>
+constexpr std::size_t dynamic_ring_storage<T, Allocator>::initial_buffer_size;
+
+/**
+ * @brief An unbounded FIFO queue storage made of linked fixed-size segments, recycling retired segments.
+ *
+ * @details Like msd::queue_storage, it grows without limit, but emptied segments are kept in a free list (up to
+ * **MaxFreeSegments**) and reused when the storage grows again, so a channel whose size goes up and down within the
+ * retained memory performs no allocation in steady state. Elements are constructed in place and destroyed when popped.
+ *
+ * @tparam T Type of elements stored.
+ * @tparam SegmentSize Number of elements in a segment.
+ * @tparam MaxFreeSegments Maximum number of retired segments kept for reuse.
+ * @tparam Allocator Allocator of the elements, rebound to allocate the segments.
+ */
+template <typename T, std::size_t SegmentSize = 64, std::size_t MaxFreeSegments = 4,
+          typename Allocator = std::allocator<T>>
+class segmented_storage {
+   public:
+    static_assert(SegmentSize > 0, "Segment size must be greater than zero.");
+
+    /**
+     * @brief The allocator of the elements.
+     */
+    using allocator_type = Allocator;
+
+    /**
+     * @brief Constructs the storage (capacity ignored, required for interface compatibility).
+     *
+     * @param allocator Allocator of the elements.
+     * @warning Do not construct manually. This constructor may change anytime.
+     */
+    explicit segmented_storage(std::size_t, const Allocator& allocator = Allocator()) : allocator_{allocator} {}
+
+    /**
+     * @brief Adds an element to the back of the storage.
+     *
+     * @tparam Type Type of the element to insert.
+     * @param value The value to insert (perfect forwarded).
+     */
+    template <typename Type>
+    void push_back(Type&& value)
+    {
+        emplace_back(std::forward<Type>(value));
+    }
+
+    /**
+     * @brief Constructs an element in place at the back of the storage.
+     *
+     * @tparam Args Types of the arguments of the element's constructor.
+     * @param args The arguments of the element's constructor (perfect forwarded).
+     */
+    template <typename... Args>
+    void emplace_back(Args&&... args)
+    {
+        if (tail_ != nullptr && back_ < SegmentSize) {
+            traits::construct(allocator_, tail_->slot(back_), std::forward<Args>(args)...);
+            ++back_;
+            ++size_;
+            return;
+        }
+
+        // The new segment is linked only after the element is built in it, so a throwing constructor leaves the
+        // storage unchanged.
+        segment* const next = acquire_segment();
+        try {
+            traits::construct(allocator_, next->slot(0), std::forward<Args>(args)...);
+        }
+        catch (...) {
+            retire(next);
+            throw;
+        }
+
+        if (tail_ != nullptr) {
+            tail_->next = next;
+        }
+        else {
+            head_ = next;
+        }
+        tail_ = next;
+        back_ = 1;
+        ++size_;
+    }
+
+    /**
+     * @brief Removes the front element from the storage and moves it to the output.
+     *
+     * @param out Reference to the variable where the front element will be moved.
+     * @warning It's undefined behaviour to pop from an empty storage.
+     */
+    void pop_front(T& out)
+    {
+        out = std::move(front());
+        pop_front();
+    }
+
+    /**
+     * @brief Returns the front element.
+     *
+     * @return Reference to the front element.
+     * @warning It's undefined behaviour to access the front of an empty storage.
+     */
+    T& front() noexcept { return *head_->slot(front_); }
+
+    /**
+     * @brief Removes the front element.
+     *
+     * @warning It's undefined behaviour to pop from an empty storage.
+     */
+    void pop_front()
+    {
+        traits::destroy(allocator_, head_->slot(front_));
+        ++front_;
+        --size_;
+
+        if (size_ == 0) {
+            // The segment of the last element is reused from its beginning, any empty one after it is retired.
+            segment* extra = head_->next;
+            head_->next = nullptr;
+            tail_ = head_;
+            while (extra != nullptr) {
+                segment* const next = extra->next;
+                retire(extra);
+                extra = next;
+            }
+
+            front_ = 0;
+            back_ = 0;
+        }
+        else if (front_ == SegmentSize) {
+            segment* const next = head_->next;
+            retire(head_);
+            head_ = next;
+            front_ = 0;
+        }
+    }
+
+    /**
+     * @brief Returns the number of elements currently stored.
+     *
+     * @return Current size.
+     */
+    NODISCARD std::size_t size() const noexcept { return size_; }
+
+    segmented_storage(const segmented_storage&) = delete;
+    segmented_storage& operator=(const segmented_storage&) = delete;
+    segmented_storage(segmented_storage&&) = delete;
+    segmented_storage& operator=(segmented_storage&&) = delete;
+
+    /**
+     * @brief Destroys the elements left in the storage and releases all segments.
+     */
+    ~segmented_storage()
+    {
+        while (size_ > 0) {
+            pop_front();
+        }
+
+        release(head_);
+        while (free_ != nullptr) {
+            segment* const next = free_->next;
+            release(free_);
+            free_ = next;
+        }
+    }
+
+   private:
+    struct segment {
+        struct alignas(T) raw_slot {
+            unsigned char bytes[sizeof(T)];
+        };
+
+        raw_slot slots[SegmentSize];
+        segment* next{};
+
+        T* slot(const std::size_t index) noexcept { return reinterpret_cast<T*>(&slots[index]); }
+    };
+
+    using traits = std::allocator_traits<Allocator>;
+    using segment_allocator = typename traits::template rebind_alloc<segment>;
+    using segment_traits = std::allocator_traits<segment_allocator>;
+
+    Allocator allocator_;
+    segment* head_{};
+    segment* tail_{};
+    segment* free_{};
+    std::size_t free_count_{0};
+    std::size_t front_{0};
+    std::size_t back_{0};
+    std::size_t size_{0};
+
+    // Takes a retired segment, or allocates one if there is none.
+    segment* acquire_segment()
+    {
+        segment* next{};
+        if (free_ != nullptr) {
+            next = free_;
+            free_ = free_->next;
+            --free_count_;
+        }
+        else {
+            segment_allocator allocator{allocator_};
+            next = ::new (static_cast<void*>(segment_traits::allocate(allocator, 1))) segment;
+        }
+        next->next = nullptr;
+
+        return next;
+    }
+
+    void retire(segment* const retired) noexcept
+    {
+        if (free_count_ < MaxFreeSegments) {
+            retired->next = free_;
+            free_ = retired;
+            ++free_count_;
+        }
+        else {
+            release(retired);
+        }
+    }
+
+    void release(segment* const released) noexcept
+    {
+        if (released == nullptr) {
+            return;
+        }
+
+        segment_allocator allocator{allocator_};
+        released->~segment();
+        segment_traits::deallocate(allocator, released, 1);
+    }
+};
+
+/**
+ * @brief A storage delivering the element with the highest priority first, using a binary heap over std::vector.
+ *
+ * @details Plugs into msd::channel instead of a FIFO storage, so urgent elements overtake the ones already queued.
+ * Push and pop are O(log n). Like std::priority_queue, the greatest element according to **Compare** is the front.
+ * Elements with equal priority come out in no particular order (see msd::stable_priority_storage). The channel's
+ * capacity bounds the storage, and the memory for it is reserved in advance.
+ *
+ * @tparam T Type of elements stored.
+ * @tparam Compare Strict weak ordering of the elements; the greatest is delivered first. Default: std::less.
+ * @tparam Allocator Allocator of the elements.
+ */
+template <typename T, typename Compare = std::less<T>, typename Allocator = std::allocator<T>>
+class priority_storage {
+   public:
+    /**
+     * @brief The allocator of the elements.
+     */
+    using allocator_type = Allocator;
+
+    /**
+     * @brief Constructs the storage with a given capacity.
+     *
+     * @param capacity Maximum number of elements the storage can hold.
+     * @param allocator Allocator of the elements.
+     * @note Reserves the memory in advance.
+     * @warning Do not construct manually. This constructor may change anytime.
+     */
+    explicit priority_storage(std::size_t capacity, const Allocator& allocator = Allocator()) : heap_{allocator}
+    {
+        heap_.reserve(capacity);
+    }
+
+    /**
+     * @brief Adds an element to the storage, by its priority.
+     *
+     * @tparam Type Type of the element to insert.
+     * @param value The value to insert (perfect forwarded).
+     */
+    template <typename Type>
+    void push_back(Type&& value)
+    {
+        heap_.push_back(std::forward<Type>(value));
+        std::push_heap(heap_.begin(), heap_.end(), compare_);
+    }
+
+    /**
+     * @brief Constructs an element in place in the storage, by its priority.
+     *
+     * @tparam Args Types of the arguments of the element's constructor.
+     * @param args The arguments of the element's constructor (perfect forwarded).
+     */
+    template <typename... Args>
+    void emplace_back(Args&&... args)
+    {
+        heap_.emplace_back(std::forward<Args>(args)...);
+        std::push_heap(heap_.begin(), heap_.end(), compare_);
+    }
+
+    /**
+     * @brief Removes the element with the highest priority and moves it to the output.
+     *
+     * @param out Reference to the variable where the element will be moved.
+     * @warning It's undefined behaviour to pop from an empty storage.
+     */
+    void pop_front(T& out)
+    {
+        std::pop_heap(heap_.begin(), heap_.end(), compare_);
+        out = std::move(heap_.back());
+        heap_.pop_back();
+    }
+
+    /**
+     * @brief Returns the element with the highest priority.
+     *
+     * @return Reference to the front element.
+     * @warning It's undefined behaviour to access the front of an empty storage. Changing the priority of the front
+     * element is allowed only right before removing it.
+     */
+    T& front() noexcept { return heap_.front(); }
+
+    /**
+     * @brief Removes the element with the highest priority.
+     *
+     * @warning It's undefined behaviour to pop from an empty storage.
+     */
+    void pop_front()
+    {
+        std::pop_heap(heap_.begin(), heap_.end(), compare_);
+        heap_.pop_back();
+    }
+
+    /**
+     * @brief Returns the number of elements currently stored.
+     *
+     * @return Current size.
+     */
+    NODISCARD std::size_t size() const noexcept { return heap_.size(); }
+
+   private:
+    std::vector<T, Allocator> heap_;
+    Compare compare_{};
+};
+
+/**
+ * @brief Like msd::priority_storage, but elements with equal priority are delivered in FIFO order.
+ *
+ * @details Each element is stored with a sequence number, which breaks ties between equal priorities.
+ *
+ * @tparam T Type of elements stored.
+ * @tparam Compare Strict weak ordering of the elements; the greatest is delivered first. Default: std::less.
+ * @tparam Allocator Allocator of the elements, rebound to allocate the elements with their sequence numbers.
+ */
+template <typename T, typename Compare = std::less<T>, typename Allocator = std::allocator<T>>
+class stable_priority_storage {
+   public:
+    /**
+     * @brief The allocator of the elements.
+     */
+    using allocator_type = Allocator;
+
+    /**
+     * @brief Constructs the storage with a given capacity.
+     *
+     * @param capacity Maximum number of elements the storage can hold.
+     * @param allocator Allocator of the elements.
+     * @note Reserves the memory in advance.
+     * @warning Do not construct manually. This constructor may change anytime.
+     */
+    explicit stable_priority_storage(std::size_t capacity, const Allocator& allocator = Allocator())
+        : heap_{entry_allocator{allocator}}
+    {
+        heap_.reserve(capacity);
+    }
+
+    /**
+     * @brief Adds an element to the storage, by its priority, after the elements with the same priority.
+     *
+     * @tparam Type Type of the element to insert.
+     * @param value The value to insert (perfect forwarded).
+     */
+    template <typename Type>
+    void push_back(Type&& value)
+    {
+        emplace_back(std::forward<Type>(value));
+    }
+
+    /**
+     * @brief Constructs an element in place in the storage, by its priority, after the elements with the same
+     * priority.
+     *
+     * @tparam Args Types of the arguments of the element's constructor.
+     * @param args The arguments of the element's constructor (perfect forwarded).
+     */
+    template <typename... Args>
+    void emplace_back(Args&&... args)
+    {
+        heap_.emplace_back(next_sequence_, std::forward<Args>(args)...);
+        ++next_sequence_;
+        std::push_heap(heap_.begin(), heap_.end(), entry_compare{compare_});
+    }
+
+    /**
+     * @brief Removes the element with the highest priority and moves it to the output.
+     *
+     * @param out Reference to the variable where the element will be moved.
+     * @warning It's undefined behaviour to pop from an empty storage.
+     */
+    void pop_front(T& out)
+    {
+        std::pop_heap(heap_.begin(), heap_.end(), entry_compare{compare_});
+        out = std::move(heap_.back().value);
+        heap_.pop_back();
+    }
+
+    /**
+     * @brief Returns the element with the highest priority.
+     *
+     * @return Reference to the front element.
+     * @warning It's undefined behaviour to access the front of an empty storage. Changing the priority of the front
+     * element is allowed only right before removing it.
+     */
+    T& front() noexcept { return heap_.front().value; }
+
+    /**
+     * @brief Removes the element with the highest priority.
+     *
+     * @warning It's undefined behaviour to pop from an empty storage.
+     */
+    void pop_front()
+    {
+        std::pop_heap(heap_.begin(), heap_.end(), entry_compare{compare_});
+        heap_.pop_back();
+    }
+
+    /**
+     * @brief Returns the number of elements currently stored.
+     *
+     * @return Current size.
+     */
+    NODISCARD std::size_t size() const noexcept { return heap_.size(); }
+
+   private:
+    struct entry {
+        std::uint64_t sequence;
+        T value;
+
+        template <typename... Args>
+        explicit entry(const std::uint64_t seq, Args&&... args) : sequence{seq}, value(std::forward<Args>(args)...)
+        {
+        }
+    };
+
+    // Greater priority first, then lower sequence number first.
+    struct entry_compare {
+        const Compare& compare;
+
+        bool operator()(const entry& lhs, const entry& rhs) const
+        {
+            if (compare(lhs.value, rhs.value)) {
+                return true;
+            }
+            if (compare(rhs.value, lhs.value)) {
+                return false;
+            }
+
+            return lhs.sequence > rhs.sequence;
+        }
+    };
+
+    using entry_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<entry>;
+
+    std::vector<entry, entry_allocator> heap_;
+    Compare compare_{};
+    std::uint64_t next_sequence_{0};
+};
+
+/**
+ * @brief Element stored by msd::timestamped_storage, with the time it was pushed.
+ *
+ * @tparam T Type of the element.
+ */
+template <typename T>
+struct timestamped {
+    /**
+     * @brief When the element was pushed.
+     */
+    std::chrono::steady_clock::time_point enqueued{};
+
+    /**
+     * @brief The element.
+     */
+    T value{};
+
+    timestamped() = default;
+
+    /**
+     * @brief Constructs the element.
+     *
+     * @param time When the element was pushed.
+     * @param args The arguments of the element's constructor (perfect forwarded).
+     */
+    template <typename... Args>
+    explicit timestamped(const std::chrono::steady_clock::time_point time, Args&&... args)
+        : enqueued{time}, value(std::forward<Args>(args)...)
+    {
+    }
+};
+
+namespace detail {
+
+/**
+ * @brief Exposes the static **capacity** of a storage, if it has one.
+ */
+template <typename Storage, typename = void>
+struct storage_capacity {};
+
+/**
+ * @brief Exposes the static **capacity** of a storage, if it has one.
+ *
+ * @tparam Storage The storage type.
+ */
+template <typename Storage>
+struct storage_capacity<Storage, decltype((void)Storage::capacity, void())> {
+    /**
+     * @brief The maximum number of elements the storage can hold.
+     */
+    static constexpr std::size_t capacity = Storage::capacity;
+};
+
+template <typename Storage>
+constexpr std::size_t storage_capacity<Storage, decltype((void)Storage::capacity, void())>::capacity;
+
+}  // namespace detail
+
+/**
+ * @brief Storage adapter recording how long each element stayed in the channel.
+ *
+ * @details Each element is stored with the time it was pushed (steady clock). When it is popped, the time since then
+ * is recorded in a lock-free msd::latency_histogram, read with msd::channel::latency():
+ * `msd::channel<int, msd::timestamped_storage<int>> chan{10}; auto p99 = chan.latency().scrape().p99();`.
+ *
+ * @tparam T Type of elements stored.
+ * @tparam Storage Storage of msd::timestamped elements, static or not. Default: msd::queue_storage.
+ */
+template <typename T, typename Storage = queue_storage<timestamped<T>>>
+class timestamped_storage : public detail::storage_capacity<Storage> {
+   public:
+    /**
+     * @brief Constructs the storage if **Storage** is static.
+     */
+    timestamped_storage() = default;
+
+    /**
+     * @brief Constructs the storage if **Storage** is not static.
+     *
+     * @param capacity Maximum number of elements the storage can hold.
+     * @warning Do not construct manually. This constructor may change anytime.
+     */
+    explicit timestamped_storage(const std::size_t capacity) : storage_{capacity} {}
+
+    /**
+     * @brief Adds an element to the back of the storage, with the current time.
+     *
+     * @tparam Type Type of the element to insert.
+     * @param value The value to insert (perfect forwarded).
+     */
+    template <typename Type>
+    void push_back(Type&& value)
+    {
+        storage_.emplace_back(std::chrono::steady_clock::now(), std::forward<Type>(value));
+    }
+
+    /**
+     * @brief Constructs an element in place at the back of the storage, with the current time.
+     *
+     * @tparam Args Types of the arguments of the element's constructor.
+     * @param args The arguments of the element's constructor (perfect forwarded).
+     */
+    template <typename... Args>
+    void emplace_back(Args&&... args)
+    {
+        storage_.emplace_back(std::chrono::steady_clock::now(), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Removes the front element, moves it to the output and records its latency.
+     *
+     * @param out Reference to the variable where the front element will be moved.
+     * @warning It's undefined behaviour to pop from an empty storage.
+     */
+    void pop_front(T& out)
+    {
+        timestamped<T>& element = storage_.front();
+        out = std::move(element.value);
+        record(element);
+        storage_.pop_front();
+    }
+
+    /**
+     * @brief Returns the front element.
+     *
+     * @return Reference to the front element.
+     * @warning It's undefined behaviour to access the front of an empty storage.
+     */
+    T& front() noexcept { return storage_.front().value; }
+
+    /**
+     * @brief Removes the front element and records its latency.
+     *
+     * @warning It's undefined behaviour to pop from an empty storage.
+     */
+    void pop_front()
+    {
+        record(storage_.front());
+        storage_.pop_front();
+    }
+
+    /**
+     * @brief Returns the number of elements currently stored.
+     *
+     * @return Current size.
+     */
+    NODISCARD std::size_t size() const noexcept { return storage_.size(); }
+
+    /**
+     * @brief Returns the histogram of the time elements stayed in the storage.
+     *
+     * @return The histogram, which can be read and reset without locking the channel.
+     */
+    latency_histogram& latency() noexcept { return latency_; }
+
+   private:
+    Storage storage_;
+    latency_histogram latency_{};
+
+    void record(const timestamped<T>& element) noexcept
+    {
+        latency_.record(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                                              element.enqueued));
+    }
+};
+
+#ifdef MSD_CHANNEL_HAS_PMR
+/**
+ * @brief Storages allocating from a std::pmr::memory_resource (C++17).
+ */
+namespace pmr {
+
+/**
+ * @brief msd::queue_storage using a polymorphic allocator.
+ */
+template <typename T>
+using queue_storage = msd::queue_storage<T, std::pmr::polymorphic_allocator<T>>;
+
+/**
+ * @brief msd::vector_storage using a polymorphic allocator.
+ */
+template <typename T>
+using vector_storage = msd::vector_storage<T, std::pmr::polymorphic_allocator<T>>;
+
+/**
+ * @brief msd::dynamic_ring_storage using a polymorphic allocator.
+ */
+template <typename T>
+using dynamic_ring_storage = msd::dynamic_ring_storage<T, std::pmr::polymorphic_allocator<T>>;
+
+/**
+ * @brief msd::segmented_storage using a polymorphic allocator.
+ */
+template <typename T, std::size_t SegmentSize = 64, std::size_t MaxFreeSegments = 4>
+using segmented_storage =
+    msd::segmented_storage<T, SegmentSize, MaxFreeSegments, std::pmr::polymorphic_allocator<T>>;
+
+/**
+ * @brief msd::priority_storage using a polymorphic allocator.
+ */
+template <typename T, typename Compare = std::less<T>>
+using priority_storage = msd::priority_storage<T, Compare, std::pmr::polymorphic_allocator<T>>;
+
+/**
+ * @brief msd::stable_priority_storage using a polymorphic allocator.
+ */
+template <typename T, typename Compare = std::less<T>>
+using stable_priority_storage = msd::stable_priority_storage<T, Compare, std::pmr::polymorphic_allocator<T>>;
+
+}  // namespace pmr
+#endif
+
 }  // namespace msd
 
 #endif  // MSD_CHANNEL_STORAGE_HPP_
@@ -0,0 +1,235 @@
+// Copyright (C) 2020-2025 Andrei Avram
+
+#ifndef MSD_CHANNEL_WAIT_STRATEGY_HPP_
+#define MSD_CHANNEL_WAIT_STRATEGY_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+/** @file */
+
+namespace msd {
+
+namespace detail {
+
+/**
+ * @brief Hints the CPU that the current thread is busy-waiting.
+ */
+inline void cpu_relax() noexcept
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+/**
+ * @brief Trait to check if a wait strategy spins on the channel state (true unless it has a static **spins** member
+ * set to false).
+ */
+template <typename, typename = void>
+struct strategy_spins : std::true_type {};
+
+/**
+ * @brief Trait to check if a wait strategy spins on the channel state (true unless it has a static **spins** member
+ * set to false).
+ *
+ * @tparam WaitStrategy The wait strategy to check.
+ */
+template <typename WaitStrategy>
+struct strategy_spins<WaitStrategy, decltype((void)WaitStrategy::spins, void())>
+    : std::integral_constant<bool, WaitStrategy::spins> {};
+
+/**
+ * @brief Copy of the size and closed flag of a channel, for spinning threads to check without locking the channel.
+ *
+ * @details Updated by the channel, with its mutex locked, after each operation. It can be stale: the channel is
+ * locked and checked again before acting on it.
+ *
+ * @tparam Enabled Whether the wait strategy of the channel spins; if not, nothing is stored.
+ */
+template <bool Enabled>
+class spin_state {
+   public:
+    /**
+     * @brief Stores the state of the channel.
+     *
+     * @param size Number of elements in the channel.
+     * @param closed Whether the channel is closed.
+     */
+    void publish(const std::size_t size, const bool closed) noexcept
+    {
+        state_.store(size | (closed ? closed_bit() : 0), std::memory_order_release);
+    }
+
+    /**
+     * @brief Checks if a reader may make progress.
+     *
+     * @return true If the channel was not empty or was closed.
+     */
+    bool may_read() const noexcept { return state_.load(std::memory_order_acquire) != 0; }
+
+    /**
+     * @brief Checks if a writer may make progress.
+     *
+     * @param capacity Capacity of the channel.
+     * @return true If the channel was not full or was closed.
+     */
+    bool may_write(const std::size_t capacity) const noexcept
+    {
+        const std::size_t state = state_.load(std::memory_order_acquire);
+        return (state & ~closed_bit()) < capacity || (state & closed_bit()) != 0;
+    }
+
+   private:
+    std::atomic<std::size_t> state_{0};
+
+    static constexpr std::size_t closed_bit() noexcept
+    {
+        return std::size_t{1} << (std::numeric_limits<std::size_t>::digits - 1);
+    }
+};
+
+/**
+ * @brief Nothing is stored for wait strategies that do not spin, so the channel pays nothing for it.
+ */
+template <>
+class spin_state<false> {
+   public:
+    /**
+     * @brief Does nothing.
+     */
+    static void publish(std::size_t, bool) noexcept {}
+
+    /**
+     * @brief Never called: the wait strategy does not spin.
+     *
+     * @return false
+     */
+    static constexpr bool may_read() noexcept { return false; }
+
+    /**
+     * @brief Never called: the wait strategy does not spin.
+     *
+     * @return false
+     */
+    static constexpr bool may_write(std::size_t) noexcept { return false; }
+};
+
+}  // namespace detail
+
+/**
+ * @brief Wait strategy that parks the thread on the condition variable right away (default of msd::channel).
+ *
+ * @details A wait strategy decides what a channel does before parking a reader on an empty channel or a writer on a
+ * full channel. It must provide a static **spin** function, called with the channel locked when the thread cannot
+ * make progress, which returns with the channel locked and tells if the thread may be able to make progress now. If
+ * it returns false, the thread is parked on the condition variable. The predicate reads an atomic copy of the channel
+ * state, so spinning never takes the channel mutex: the channel is locked again only when the predicate says there
+ * may be something to do, then the channel checks its real state and spins again if another thread was faster. A
+ * strategy that never calls the predicate declares a static constexpr **spins** member set to false, then the channel
+ * does not keep the atomic copy of its state.
+ */
+struct blocking_wait {
+    /**
+     * @brief The predicate is never called.
+     */
+    static constexpr bool spins = false;
+
+    /**
+     * @brief Does not spin.
+     *
+     * @param lock The locked channel mutex.
+     * @param pred Condition to wait for, safe to check without the lock.
+     * @return false
+     */
+    template <typename Predicate>
+    static bool spin(std::unique_lock<std::mutex>& lock, Predicate pred) noexcept
+    {
+        (void)lock;
+        (void)pred;
+        return false;
+    }
+};
+
+/**
+ * @brief Wait strategy that busy-spins until the thread can make progress, never parking it.
+ *
+ * @details Gives the lowest handoff latency at the cost of a fully used CPU core for each waiting thread. Use only
+ * when there are at least as many cores as waiting threads.
+ */
+struct busy_wait {
+    /**
+     * @brief Spins until the predicate is satisfied.
+     *
+     * @param lock The locked channel mutex, released while spinning.
+     * @param pred Condition to wait for, safe to check without the lock.
+     * @return true
+     */
+    template <typename Predicate>
+    static bool spin(std::unique_lock<std::mutex>& lock, Predicate pred)
+    {
+        lock.unlock();
+        while (!pred()) {
+            detail::cpu_relax();
+        }
+        lock.lock();
+
+        return true;
+    }
+};
+
+/**
+ * @brief Wait strategy that spins, then yields, then parks the thread on the condition variable.
+ *
+ * @details Short waits are caught while spinning, with microsecond wakeups, while long waits still end up sleeping
+ * instead of burning CPU.
+ *
+ * @tparam Spins Number of times to check the predicate with a CPU pause in between.
+ * @tparam Yields Number of times to check the predicate yielding the thread in between, after spinning.
+ */
+template <std::size_t Spins = 1000, std::size_t Yields = 10>
+struct backoff_wait {
+    /**
+     * @brief Spins, then yields, until the predicate is satisfied or the attempts are exhausted.
+     *
+     * @param lock The locked channel mutex, released while spinning.
+     * @param pred Condition to wait for, safe to check without the lock.
+     * @return The value of the predicate when returning (false means the thread must be parked).
+     */
+    template <typename Predicate>
+    static bool spin(std::unique_lock<std::mutex>& lock, Predicate pred)
+    {
+        lock.unlock();
+        bool ready = false;
+
+        for (std::size_t i = 0; i < Spins && !ready; ++i) {
+            detail::cpu_relax();
+            ready = pred();
+        }
+
+        for (std::size_t i = 0; i < Yields && !ready; ++i) {
+            std::this_thread::yield();
+            ready = pred();
+        }
+
+        lock.lock();
+
+        return ready;
+    }
+};
+
+}  // namespace msd
+
+#endif  // MSD_CHANNEL_WAIT_STRATEGY_HPP_
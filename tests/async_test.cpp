@@ -0,0 +1,464 @@
+#include "msd/async.hpp"
+
+#include <gtest/gtest.h>
+
+#include "msd/channel.hpp"
+#include "msd/executor.hpp"
+#include "msd/static_channel.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+TEST(AsyncTest, CallbackReadCompletesInline)
+{
+    msd::channel<std::string> chan{2};
+    chan.write(std::string{"a"});
+
+    std::string out{};
+    chan.async_read([&out](const msd::channel_status status, std::string&& value) {
+        EXPECT_EQ(status, msd::channel_status::kOk);
+        out = std::move(value);
+    });
+
+    EXPECT_EQ(out, "a");
+    EXPECT_TRUE(chan.empty());
+}
+
+TEST(AsyncTest, CallbackReadWaitsForWrite)
+{
+    msd::channel<std::string> chan{2};
+
+    std::vector<std::string> values{};
+    const auto handler = [&values](const msd::channel_status status, std::string value) {
+        EXPECT_EQ(status, msd::channel_status::kOk);
+        values.push_back(std::move(value));
+    };
+    chan.async_read(handler);
+    chan.async_read(handler);
+    EXPECT_TRUE(values.empty());
+
+    // Readers are served in order, by the writer
+    chan << std::string{"a"};
+    EXPECT_EQ(values, (std::vector<std::string>{"a"}));
+
+    EXPECT_EQ(chan.try_write(std::string{"b"}), msd::channel_status::kOk);
+    EXPECT_EQ(values, (std::vector<std::string>{"a", "b"}));
+    EXPECT_TRUE(chan.empty());
+}
+
+TEST(AsyncTest, CallbackWriteWaitsForSpace)
+{
+    msd::channel<int> chan{1};
+
+    std::vector<msd::channel_status> statuses{};
+    const auto handler = [&statuses](const msd::channel_status status) { statuses.push_back(status); };
+    chan.async_write(1, handler);
+    chan.async_write(2, handler);
+    EXPECT_EQ(statuses.size(), 1);
+
+    int out{};
+    chan >> out;
+    EXPECT_EQ(out, 1);
+    EXPECT_EQ(statuses.size(), 2);
+
+    // Move-only handlers are supported
+    struct move_only_handler {
+        std::unique_ptr<int> value;
+        std::vector<msd::channel_status>* statuses;
+
+        void operator()(const msd::channel_status status) const
+        {
+            EXPECT_EQ(*value, 3);
+            statuses->push_back(status);
+        }
+    };
+    chan.async_write(3, move_only_handler{std::unique_ptr<int>{new int{3}}, &statuses});
+
+    chan.close();
+    EXPECT_EQ(statuses, (std::vector<msd::channel_status>{msd::channel_status::kOk, msd::channel_status::kOk,
+                                                          msd::channel_status::kClosed}));
+
+    chan >> out;
+    EXPECT_EQ(out, 2);
+}
+
+TEST(AsyncTest, CallbackReadOnClosedChannel)
+{
+    msd::static_channel<int, 2> chan{};
+    chan << 1;
+
+    int calls{};
+    chan.async_read([&calls](const msd::channel_status, int) { ++calls; });
+    chan.async_read([&calls](const msd::channel_status status, int) {
+        EXPECT_EQ(status, msd::channel_status::kClosed);
+        ++calls;
+    });
+    EXPECT_EQ(calls, 1);
+
+    chan.close();
+    EXPECT_EQ(calls, 2);
+
+    chan.async_read([&calls](const msd::channel_status status, int) {
+        EXPECT_EQ(status, msd::channel_status::kClosed);
+        ++calls;
+    });
+    EXPECT_EQ(calls, 3);
+}
+
+TEST(AsyncTest, CallbacksOnExecutor)
+{
+    const int numbers = 1000;
+    msd::channel<int> chan{4};
+    std::atomic<std::int64_t> sum{0};
+    std::atomic<int> written{0};
+
+    {
+        msd::executor executor{2};
+
+        // Each handler queues the next read, so a single consumer reads all elements without a dedicated thread
+        struct reader {
+            msd::channel<int>* chan;
+            msd::executor* executor;
+            std::atomic<std::int64_t>* sum;
+
+            void operator()(const msd::channel_status status, const int value) const
+            {
+                if (status == msd::channel_status::kOk) {
+                    *sum += value;
+                    chan->async_read(*this, *executor);
+                }
+            }
+        };
+        chan.async_read(reader{&chan, &executor, &sum}, executor);
+
+        for (int i = 1; i <= numbers; ++i) {
+            chan.async_write(i, [&written](const msd::channel_status status) {
+                if (status == msd::channel_status::kOk) {
+                    ++written;
+                }
+            }, executor);
+        }
+
+        while (written < numbers) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        chan.close();
+    }
+
+    EXPECT_EQ(sum, static_cast<std::int64_t>(numbers) * (numbers + 1) / 2);
+    EXPECT_TRUE(chan.drained());
+}
+
+TEST(AsyncTest, DestroyingChannelCompletesQueuedCallbacks)
+{
+    const auto owned = std::make_shared<int>(0);
+    std::vector<msd::channel_status> statuses{};
+
+    {
+        msd::channel<int> empty{1};
+        empty.async_read([owned, &statuses](const msd::channel_status status, int) { statuses.push_back(status); });
+
+        msd::channel<int> full{1};
+        full << 1;
+        full.async_write(2, [owned, &statuses](const msd::channel_status status) { statuses.push_back(status); });
+
+        EXPECT_EQ(owned.use_count(), 3);
+    }
+
+    EXPECT_EQ(statuses, (std::vector<msd::channel_status>{msd::channel_status::kClosed, msd::channel_status::kClosed}));
+    EXPECT_EQ(owned.use_count(), 1);
+}
+
+// Executor that cannot accept tasks.
+struct failing_executor {
+    template <typename Function>
+    void post(Function&&)
+    {
+        throw std::bad_alloc{};
+    }
+};
+
+TEST(AsyncTest, FailedDispatchIsThrownToTheCompletingCaller)
+{
+    const auto owned = std::make_shared<int>(0);
+    bool called = false;
+    failing_executor executor{};
+
+    msd::channel<int> chan{1};
+    chan.async_read([owned, &called](msd::channel_status, int) { called = true; }, executor);
+
+    // The element is handed to the queued read, whose handler cannot be posted
+    EXPECT_THROW(chan.write(1), std::bad_alloc);
+    EXPECT_FALSE(called);
+    EXPECT_EQ(owned.use_count(), 1);
+
+    // Completing right away throws to the caller starting the operation
+    chan << 2;
+    EXPECT_THROW(chan.async_read([owned, &called](msd::channel_status, int) { called = true; }, executor),
+                 std::bad_alloc);
+    EXPECT_FALSE(called);
+    EXPECT_EQ(owned.use_count(), 1);
+    EXPECT_TRUE(chan.empty());
+}
+
+#ifdef MSD_CHANNEL_HAS_COROUTINES
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+
+namespace {
+
+// Coroutine running eagerly until its first suspension, destroyed when it finishes.
+struct task {
+    struct promise_type {
+        task get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+task read_one(msd::channel<std::string>& chan, std::optional<std::string>& out, bool& done)
+{
+    out = co_await chan.async_read();
+    done = true;
+}
+
+task write_one(msd::channel<std::string>& chan, std::string value, bool& written, bool& done)
+{
+    written = co_await chan.async_write(std::move(value));
+    done = true;
+}
+
+}  // namespace
+
+TEST(AsyncTest, ReadCompletesWithoutSuspending)
+{
+    msd::channel<std::string> chan{2};
+    chan.write(std::string{"a"});
+
+    std::optional<std::string> out{};
+    bool done{};
+    read_one(chan, out, done);
+
+    EXPECT_TRUE(done);
+    ASSERT_TRUE(out.has_value());
+    EXPECT_EQ(*out, "a");
+    EXPECT_TRUE(chan.empty());
+}
+
+TEST(AsyncTest, ReadSuspendsUntilWrite)
+{
+    msd::channel<std::string> chan{2};
+
+    std::optional<std::string> first{};
+    bool first_done{};
+    read_one(chan, first, first_done);
+
+    std::optional<std::string> second{};
+    bool second_done{};
+    read_one(chan, second, second_done);
+
+    EXPECT_FALSE(first_done);
+    EXPECT_FALSE(second_done);
+
+    // Readers are resumed in order, by the writer
+    chan.write(std::string{"a"});
+    EXPECT_TRUE(first_done);
+    EXPECT_FALSE(second_done);
+    EXPECT_EQ(*first, "a");
+
+    EXPECT_EQ(chan.try_write(std::string{"b"}), msd::channel_status::kOk);
+    EXPECT_TRUE(second_done);
+    EXPECT_EQ(*second, "b");
+    EXPECT_TRUE(chan.empty());
+}
+
+TEST(AsyncTest, WriteSuspendsUntilRead)
+{
+    msd::channel<std::string> chan{1};
+
+    bool first_written{};
+    bool first_done{};
+    write_one(chan, "a", first_written, first_done);
+    EXPECT_TRUE(first_done);
+    EXPECT_TRUE(first_written);
+
+    bool second_written{};
+    bool second_done{};
+    write_one(chan, "b", second_written, second_done);
+    EXPECT_FALSE(second_done);
+    EXPECT_EQ(chan.size(), 1);
+
+    // The read makes space: the suspended writer pushes its element and is resumed
+    std::string out{};
+    chan >> out;
+    EXPECT_EQ(out, "a");
+    EXPECT_TRUE(second_done);
+    EXPECT_TRUE(second_written);
+
+    chan >> out;
+    EXPECT_EQ(out, "b");
+}
+
+TEST(AsyncTest, WriterHandsElementToReader)
+{
+    msd::channel<std::string> chan{1};
+    chan.write(std::string{"a"});
+
+    bool written{};
+    bool write_done{};
+    write_one(chan, "b", written, write_done);
+    EXPECT_FALSE(write_done);
+
+    std::optional<std::string> out{};
+    bool read_done{};
+    read_one(chan, out, read_done);
+    EXPECT_TRUE(read_done);
+    EXPECT_EQ(*out, "a");
+    EXPECT_TRUE(write_done);
+
+    read_one(chan, out, read_done);
+    EXPECT_EQ(*out, "b");
+}
+
+TEST(AsyncTest, CloseResumesWaiters)
+{
+    msd::channel<std::string> empty{1};
+    std::optional<std::string> out{"value"};
+    bool read_done{};
+    read_one(empty, out, read_done);
+
+    msd::channel<std::string> full{1};
+    full.write(std::string{"a"});
+    bool written{true};
+    bool write_done{};
+    write_one(full, "b", written, write_done);
+
+    empty.close();
+    full.close();
+
+    EXPECT_TRUE(read_done);
+    EXPECT_FALSE(out.has_value());
+    EXPECT_TRUE(write_done);
+    EXPECT_FALSE(written);
+
+    // Elements written before closing are still read
+    read_done = false;
+    read_one(full, out, read_done);
+    EXPECT_TRUE(read_done);
+    EXPECT_EQ(*out, "a");
+
+    read_one(full, out, read_done);
+    EXPECT_FALSE(out.has_value());
+
+    write_one(full, "c", written, write_done);
+    EXPECT_FALSE(written);
+}
+
+TEST(AsyncTest, RangeReadsUntilDrained)
+{
+    msd::static_channel<int, 4> chan{};
+    std::vector<int> values{};
+    bool done{};
+
+    auto consume = [](msd::static_channel<int, 4>& in, std::vector<int>& out, bool& finished) -> task {
+        msd::async_range<msd::static_channel<int, 4>> range{in};
+        for (auto it = co_await range.begin(); it != range.end(); co_await ++it) {
+            out.push_back(*it);
+        }
+        finished = true;
+    };
+    consume(chan, values, done);
+
+    chan << 1 << 2;
+    EXPECT_EQ(values, (std::vector<int>{1, 2}));
+
+    chan << 3;
+    chan.close();
+    EXPECT_TRUE(done);
+    EXPECT_EQ(values, (std::vector<int>{1, 2, 3}));
+}
+
+TEST(AsyncTest, ResumesOnExecutor)
+{
+    const int numbers = 1000;
+    msd::channel<int> chan{4};
+    std::atomic<std::int64_t> sum{0};
+    std::atomic<bool> done{false};
+
+    msd::executor executor{2};
+
+    auto consume = [](msd::channel<int>& in, msd::executor& exec, std::atomic<std::int64_t>& total,
+                      std::atomic<bool>& finished) -> task {
+        while (auto value = co_await in.async_read().on(exec)) {
+            total += *value;
+        }
+        finished = true;
+    };
+
+    auto produce = [](msd::channel<int>& out, msd::executor& exec) -> task {
+        for (int i = 1; i <= numbers; ++i) {
+            co_await out.async_write(i).on(exec);
+        }
+        out.close();
+    };
+
+    consume(chan, executor, sum, done);
+    produce(chan, executor);
+
+    while (!done) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    EXPECT_EQ(sum, static_cast<std::int64_t>(numbers) * (numbers + 1) / 2);
+    EXPECT_TRUE(chan.drained());
+}
+
+TEST(AsyncTest, MixesWithBlockingThreads)
+{
+    const int numbers = 10000;
+    msd::channel<int> chan{8};
+    std::atomic<std::int64_t> async_sum{0};
+    std::atomic<bool> done{false};
+
+    // Resumed inline, on the writer thread
+    auto consume = [](msd::channel<int>& in, std::atomic<std::int64_t>& total, std::atomic<bool>& finished) -> task {
+        while (auto value = co_await in.async_read()) {
+            total += *value;
+        }
+        finished = true;
+    };
+    consume(chan, async_sum, done);
+
+    std::int64_t blocking_sum{0};
+    std::thread reader{[&chan, &blocking_sum]() {
+        for (const int value : chan) {
+            blocking_sum += value;
+        }
+    }};
+
+    std::thread writer{[&chan]() {
+        for (int i = 1; i <= numbers; ++i) {
+            chan << i;
+        }
+        chan.close();
+    }};
+
+    writer.join();
+    reader.join();
+
+    EXPECT_TRUE(done);
+    EXPECT_EQ(async_sum + blocking_sum, static_cast<std::int64_t>(numbers) * (numbers + 1) / 2);
+}
+
+#endif
@@ -4,6 +4,8 @@
 
 #include <msd/channel.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <iterator>
 #include <thread>
 #include <vector>
@@ -50,6 +52,38 @@ TEST(BlockingIteratorTest, EmptyChannelClosesGracefully)
     EXPECT_FALSE(it != end);
 }
 
+TEST(DeadlineIteratorTest, StopsWhenChannelIsDrained)
+{
+    msd::channel<int> channel{10};
+    channel.write(1);
+    channel.write(2);
+    channel.close();
+
+    std::vector<int> results;
+    for (auto value : msd::until(channel, std::chrono::steady_clock::now() + std::chrono::seconds(10))) {
+        results.push_back(value);
+    }
+
+    EXPECT_EQ(results, (std::vector<int>{1, 2}));
+}
+
+TEST(DeadlineIteratorTest, StopsAtDeadline)
+{
+    msd::channel<int> channel{10};
+    channel.write(1);
+    channel.write(2);
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(20);
+    auto range = msd::until(channel, deadline);
+
+    std::vector<int> results;
+    std::copy(range.begin(), range.end(), std::back_inserter(results));
+
+    EXPECT_EQ(results, (std::vector<int>{1, 2}));
+    EXPECT_GE(std::chrono::steady_clock::now(), deadline);
+    EXPECT_FALSE(channel.closed());
+}
+
 TEST(BlockingWriterIteratorTest, Traits)
 {
     using type = int;
@@ -0,0 +1,246 @@
+#include "msd/broadcast_channel.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+TEST(BroadcastChannelTest, Traits)
+{
+    using type = int;
+    using subscription = msd::broadcast_subscription<type>;
+    EXPECT_TRUE((std::is_same<subscription::value_type, type>::value));
+
+    using iterator = msd::blocking_iterator<msd::broadcast_subscription<type>>;
+    EXPECT_TRUE((std::is_same<subscription::iterator, iterator>::value));
+
+    EXPECT_TRUE((std::is_same<msd::broadcast_channel<type>::size_type, std::size_t>::value));
+}
+
+TEST(BroadcastChannelTest, EverySubscriberSeesEveryElement)
+{
+    msd::broadcast_channel<std::string> channel{4};
+    EXPECT_EQ(channel.capacity(), 4);
+
+    // Written before subscribing: discarded
+    EXPECT_TRUE(channel.write(std::string{"lost"}));
+    EXPECT_EQ(channel.size(), 0);
+
+    auto first = channel.subscribe();
+    auto second = channel.subscribe();
+    EXPECT_EQ(channel.subscribers(), 2);
+
+    channel << std::string{"a"} << std::string{"b"};
+    EXPECT_EQ(channel.size(), 2);
+    EXPECT_EQ(first.size(), 2);
+
+    std::string out{};
+    EXPECT_TRUE(first.read(out));
+    EXPECT_EQ(out, "a");
+    first >> out;
+    EXPECT_EQ(out, "b");
+    EXPECT_EQ(first.try_read(out), msd::channel_status::kEmpty);
+
+    // The slowest subscriber keeps the elements
+    EXPECT_EQ(channel.size(), 2);
+
+    EXPECT_EQ(second.try_read(out), msd::channel_status::kOk);
+    EXPECT_EQ(out, "a");
+    EXPECT_TRUE(second.consume([](const std::string& value) { EXPECT_EQ(value, "b"); }));
+    EXPECT_EQ(channel.size(), 0);
+}
+
+TEST(BroadcastChannelTest, SubscriberSeesElementsWrittenAfterSubscribing)
+{
+    msd::broadcast_channel<int> channel{4};
+
+    auto first = channel.subscribe();
+    channel.write(1);
+
+    auto second = channel.subscribe();
+    channel.write(2);
+
+    int out = 0;
+    EXPECT_TRUE(second.read(out));
+    EXPECT_EQ(out, 2);
+    EXPECT_EQ(second.try_read(out), msd::channel_status::kEmpty);
+
+    EXPECT_TRUE(first.read(out));
+    EXPECT_EQ(out, 1);
+    EXPECT_TRUE(first.read(out));
+    EXPECT_EQ(out, 2);
+}
+
+TEST(BroadcastChannelTest, SlowestSubscriberBlocksWriters)
+{
+    msd::broadcast_channel<int> channel{2};
+    auto fast = channel.subscribe();
+    auto slow = channel.subscribe();
+
+    EXPECT_EQ(channel.try_write(1), msd::channel_status::kOk);
+    EXPECT_EQ(channel.try_write(2), msd::channel_status::kOk);
+
+    int out = 0;
+    fast.read(out);
+    fast.read(out);
+
+    EXPECT_EQ(channel.try_write(3), msd::channel_status::kFull);
+    EXPECT_EQ(channel.write_for(3, std::chrono::milliseconds(10)), msd::channel_status::kTimeout);
+
+    std::thread writer{[&channel]() { EXPECT_TRUE(channel.write(3)); }};
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    slow.read(out);
+    EXPECT_EQ(out, 1);
+    writer.join();
+
+    EXPECT_TRUE(fast.read(out));
+    EXPECT_EQ(out, 3);
+}
+
+TEST(BroadcastChannelTest, UnsubscribingFreesSpace)
+{
+    msd::broadcast_channel<int> channel{1};
+    auto fast = channel.subscribe();
+
+    {
+        auto slow = channel.subscribe();
+        channel.write(1);
+
+        int out = 0;
+        fast.read(out);
+        EXPECT_EQ(channel.try_write(2), msd::channel_status::kFull);
+    }
+
+    EXPECT_EQ(channel.subscribers(), 1);
+    EXPECT_EQ(channel.try_write(2), msd::channel_status::kOk);
+}
+
+TEST(BroadcastChannelTest, DropSlowest)
+{
+    msd::broadcast_channel<int> channel{2, msd::broadcast_overflow::kDropSlowest};
+    auto fast = channel.subscribe();
+    auto slow = channel.subscribe();
+
+    int out = 0;
+    for (int i = 1; i <= 5; ++i) {
+        EXPECT_EQ(channel.try_write(i), msd::channel_status::kOk);
+        EXPECT_TRUE(fast.read(out));
+        EXPECT_EQ(out, i);
+    }
+
+    EXPECT_TRUE(slow.dropped());
+    EXPECT_TRUE(slow.drained());
+    EXPECT_EQ(slow.size(), 0);
+    EXPECT_FALSE(slow.read(out));
+    EXPECT_EQ(slow.try_read(out), msd::channel_status::kClosed);
+
+    EXPECT_FALSE(fast.dropped());
+}
+
+TEST(BroadcastChannelTest, Close)
+{
+    msd::broadcast_channel<int> channel{4};
+    auto sub = channel.subscribe();
+    channel.write(1);
+
+    std::thread reader{[&sub]() {
+        int out = 0;
+        EXPECT_TRUE(sub.read(out));
+        EXPECT_EQ(out, 1);
+        EXPECT_FALSE(sub.read(out));
+    }};
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    channel.close();
+    reader.join();
+
+    EXPECT_TRUE(channel.closed());
+    EXPECT_TRUE(sub.drained());
+    EXPECT_FALSE(channel.write(2));
+    EXPECT_EQ(channel.try_write(2), msd::channel_status::kClosed);
+    EXPECT_THROW(channel << 2, msd::closed_channel);
+
+    int out = 0;
+    EXPECT_EQ(sub.read_for(out, std::chrono::milliseconds(10)), msd::channel_status::kClosed);
+}
+
+TEST(BroadcastChannelTest, MoveSubscription)
+{
+    msd::broadcast_channel<int> channel{4};
+
+    auto first = channel.subscribe();
+    msd::broadcast_subscription<int> moved{std::move(first)};
+    EXPECT_EQ(channel.subscribers(), 1);
+
+    auto other = channel.subscribe();
+    other = std::move(moved);
+    EXPECT_EQ(channel.subscribers(), 1);
+
+    channel.write(1);
+    int out = 0;
+    EXPECT_TRUE(other.read(out));
+    EXPECT_EQ(out, 1);
+}
+
+TEST(BroadcastChannelTest, SharedPayloadIsNotCopiedPerSubscriber)
+{
+    msd::broadcast_channel<std::shared_ptr<int>> channel{4};
+    auto first = channel.subscribe();
+    auto second = channel.subscribe();
+
+    const auto payload = std::make_shared<int>(1);
+    channel.write(payload);
+    EXPECT_EQ(payload.use_count(), 2);
+
+    EXPECT_TRUE(first.consume([&payload](const std::shared_ptr<int>& value) { EXPECT_EQ(value, payload); }));
+    EXPECT_TRUE(second.consume([&payload](const std::shared_ptr<int>& value) { EXPECT_EQ(value, payload); }));
+    EXPECT_EQ(payload.use_count(), 2);
+}
+
+TEST(BroadcastChannelTest, Multithreading)
+{
+    const int numbers = 10000;
+    const int subscribers = 4;
+    const std::int64_t expected_sum = static_cast<std::int64_t>(numbers) * (numbers + 1) / 2;
+
+    msd::broadcast_channel<int> channel{16};
+
+    std::vector<msd::broadcast_subscription<int>> subscriptions;
+    for (int s = 0; s < subscribers; ++s) {
+        subscriptions.push_back(channel.subscribe());
+    }
+
+    std::vector<std::thread> readers;
+    std::vector<std::int64_t> sums(subscribers, 0);
+    for (int s = 0; s < subscribers; ++s) {
+        readers.emplace_back([&subscriptions, &sums, s]() {
+            int previous = 0;
+            for (const int value : subscriptions[static_cast<std::size_t>(s)]) {
+                EXPECT_EQ(value, previous + 1);
+                previous = value;
+                sums[static_cast<std::size_t>(s)] += value;
+            }
+        });
+    }
+
+    for (int i = 1; i <= numbers; ++i) {
+        channel << i;
+    }
+    channel.close();
+
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    for (const std::int64_t sum : sums) {
+        EXPECT_EQ(sum, expected_sum);
+    }
+}
@@ -6,9 +6,12 @@
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <future>
+#include <memory>
 #include <numeric>
+#include <stdexcept>
 #include <string>
 #include <thread>
 #include <type_traits>
@@ -32,6 +35,34 @@ TEST(ChannelTest, ConstructStaticChannel)
     EXPECT_EQ(channel.size(), 0);
 }
 
+TEST(ChannelTest, RingStorageWithNonDefaultConstructibleType)
+{
+    struct element {
+        explicit element(int number) : value{number} {}
+
+        int value;
+    };
+
+    msd::channel<element, msd::ring_storage<element, 3>> channel;
+
+    std::thread writer{[&channel]() {
+        for (int i = 1; i <= 10; ++i) {
+            channel << element{i};
+        }
+        channel.close();
+    }};
+
+    element out{0};
+    int expected = 1;
+    while (channel.read(out)) {
+        EXPECT_EQ(out.value, expected);
+        ++expected;
+    }
+    EXPECT_EQ(expected, 11);
+
+    writer.join();
+}
+
 TEST(ChannelTest, PushAndFetch)
 {
     msd::channel<int> channel;
@@ -116,6 +147,208 @@ TEST(ChannelTest, PushAndFetchWithBufferedChannel)
     read_thread.join();
 }
 
+TEST(ChannelTest, WriteRange)
+{
+    msd::channel<int> channel;
+
+    const std::vector<int> input{1, 2, 3};
+    EXPECT_EQ(channel.write(input.begin(), input.end()), 3);
+    EXPECT_EQ(channel.write(input.begin(), input.begin()), 0);
+    EXPECT_EQ(channel.size(), 3);
+
+    channel.close();
+    EXPECT_EQ(channel.write(input.begin(), input.end()), 0);
+
+    std::vector<int> output;
+    std::copy(channel.begin(), channel.end(), std::back_inserter(output));
+    EXPECT_EQ(output, input);
+}
+
+template <typename Channel>
+void write_range_larger_than_capacity(Channel& channel)
+{
+    std::vector<std::string> input;
+    for (int i = 0; i < 100; ++i) {
+        input.push_back(std::to_string(i));
+    }
+    std::vector<std::string> moved_input = input;
+
+    std::thread writer{[&]() {
+        EXPECT_EQ(channel.write(std::make_move_iterator(moved_input.begin()),
+                                std::make_move_iterator(moved_input.end())),
+                  input.size());
+        channel.close();
+    }};
+
+    std::vector<std::string> output;
+    std::copy(channel.begin(), channel.end(), std::back_inserter(output));
+    writer.join();
+
+    EXPECT_EQ(output, input);
+}
+
+TEST(ChannelTest, WriteRangeLargerThanCapacity)
+{
+    msd::channel<std::string> queue_channel{3};
+    write_range_larger_than_capacity(queue_channel);
+
+    msd::channel<std::string, msd::vector_storage<std::string>> vector_channel{3};
+    write_range_larger_than_capacity(vector_channel);
+
+    msd::channel<std::string, msd::dynamic_ring_storage<std::string>> ring_channel{3};
+    write_range_larger_than_capacity(ring_channel);
+
+    msd::static_channel<std::string, 3> array_channel{};
+    write_range_larger_than_capacity(array_channel);
+}
+
+TEST(ChannelTest, WriteRangeStopsWhenClosed)
+{
+    msd::channel<int> channel{2};
+
+    const std::vector<int> input{1, 2, 3, 4};
+    std::thread writer{[&]() { EXPECT_EQ(channel.write(input.begin(), input.end()), 2); }};
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    channel.close();
+    writer.join();
+
+    EXPECT_EQ(channel.size(), 2);
+}
+
+TEST(ChannelTest, ReadN)
+{
+    msd::channel<std::string> channel;
+    channel << std::string{"1"} << std::string{"2"} << std::string{"3"};
+
+    std::vector<std::string> output;
+    EXPECT_EQ(channel.read_n(std::back_inserter(output), 2), 2);
+    EXPECT_EQ(output, (std::vector<std::string>{"1", "2"}));
+
+    EXPECT_EQ(channel.read_n(std::back_inserter(output), 0), 0);
+    EXPECT_EQ(channel.read_n(std::back_inserter(output), 10), 1);
+    EXPECT_EQ(output, (std::vector<std::string>{"1", "2", "3"}));
+
+    channel.close();
+    EXPECT_EQ(channel.read_n(std::back_inserter(output), 10), 0);
+}
+
+TEST(ChannelTest, Consume)
+{
+    msd::channel<std::string> channel{2};
+    channel << std::string{"abc"} << std::string{"def"};
+
+    std::string out{};
+    EXPECT_TRUE(channel.consume([&out](std::string& value) { out = value + "!"; }));
+    EXPECT_EQ(out, "abc!");
+    EXPECT_EQ(channel.size(), 1);
+
+    EXPECT_THROW(channel.consume([](const std::string&) { throw std::runtime_error{"error"}; }), std::runtime_error);
+    EXPECT_EQ(channel.size(), 1);
+
+    channel.close();
+    EXPECT_TRUE(channel.consume([&out](const std::string& value) { out = value; }));
+    EXPECT_EQ(out, "def");
+    EXPECT_FALSE(channel.consume([](const std::string&) { FAIL(); }));
+}
+
+TEST(ChannelTest, ConsumeBatch)
+{
+    const int numbers = 1000;
+
+    msd::channel<int, msd::ring_storage<int, 16>> channel{};
+
+    std::thread writer{[&channel]() {
+        for (int i = 1; i <= numbers; ++i) {
+            channel.write(i);
+        }
+        channel.close();
+    }};
+
+    int expected = 1;
+    const auto check = [&expected](const int* data, const std::size_t count) {
+        EXPECT_GT(count, 0);
+        EXPECT_LE(count, 10);
+        for (std::size_t i = 0; i < count; ++i) {
+            EXPECT_EQ(data[i], expected);
+            ++expected;
+        }
+    };
+    while (channel.consume_batch(check, 10) > 0) {
+    }
+    writer.join();
+
+    EXPECT_EQ(expected, numbers + 1);
+    EXPECT_TRUE(channel.drained());
+}
+
+TEST(ChannelTest, CustomAllocator)
+{
+    using allocator = std::allocator<int>;
+
+    msd::channel<int, msd::dynamic_ring_storage<int, allocator>> channel{10, allocator{}};
+    channel << 1 << 2;
+
+    int out = 0;
+    channel >> out;
+    EXPECT_EQ(out, 1);
+    channel >> out;
+    EXPECT_EQ(out, 2);
+
+#ifdef MSD_CHANNEL_HAS_PMR
+    std::pmr::monotonic_buffer_resource resource{};
+    msd::pmr::channel<std::pmr::string> strings{0, &resource};
+
+    strings.write("a string long enough to not fit in the small string buffer");
+    strings.consume([&resource](std::pmr::string& str) { EXPECT_EQ(str.get_allocator().resource(), &resource); });
+    EXPECT_TRUE(strings.empty());
+#endif
+}
+
+TEST(ChannelTest, PriorityStorage)
+{
+    msd::channel<int, msd::priority_storage<int>> channel{10};
+    channel << 1 << 3 << 2;
+
+    // Urgent (greater) elements overtake the queued ones
+    int out = 0;
+    channel >> out;
+    EXPECT_EQ(out, 3);
+    channel << 10;
+    channel >> out;
+    EXPECT_EQ(out, 10);
+    channel >> out;
+    EXPECT_EQ(out, 2);
+
+    msd::channel<int, msd::stable_priority_storage<int>> stable{10};
+    EXPECT_TRUE(stable.emplace(5));
+    EXPECT_TRUE(stable.consume([](int& value) { EXPECT_EQ(value, 5); }));
+}
+
+TEST(ChannelTest, DrainInto)
+{
+    const int numbers = 1000;
+
+    msd::channel<int> channel{10};
+
+    std::thread writer{[&channel]() {
+        for (int i = 1; i <= numbers; ++i) {
+            channel.write(i);
+        }
+        channel.close();
+    }};
+
+    std::vector<int> output;
+    while (channel.drain_into(output) > 0) {
+    }
+    writer.join();
+
+    std::vector<int> expected(numbers);
+    std::iota(expected.begin(), expected.end(), 1);
+    EXPECT_EQ(output, expected);
+    EXPECT_TRUE(channel.drained());
+}
+
 TEST(ChannelTest, PushAndFetchMultiple)
 {
     msd::channel<std::string> channel;
@@ -155,6 +388,203 @@ TEST(ChannelTest, PushByMoveAndFetch)
     EXPECT_EQ("def", out);
 }
 
+struct wide {
+    static int moves;
+
+    wide() = default;
+    wide(int first, std::string second) : number{first}, text{std::move(second)} {}
+    wide(const wide&) = default;
+    wide& operator=(const wide&) = default;
+    wide(wide&& other) noexcept : number{other.number}, text{std::move(other.text)} { ++moves; }
+    wide& operator=(wide&& other) noexcept
+    {
+        number = other.number;
+        text = std::move(other.text);
+        ++moves;
+        return *this;
+    }
+    ~wide() = default;
+
+    int number{};
+    std::string text{};
+};
+
+int wide::moves = 0;
+
+template <typename Channel>
+void emplace_without_moves(Channel& channel)
+{
+    wide::moves = 0;
+
+    EXPECT_TRUE(channel.emplace(1, "one"));
+    EXPECT_TRUE(channel.emplace(2, "two"));
+    EXPECT_EQ(wide::moves, 0);
+
+    wide out{};
+    channel >> out;
+    EXPECT_EQ(out.number, 1);
+    EXPECT_EQ(out.text, "one");
+    channel >> out;
+    EXPECT_EQ(out.number, 2);
+    EXPECT_EQ(out.text, "two");
+
+    channel.close();
+    EXPECT_FALSE(channel.emplace(3, "three"));
+}
+
+TEST(ChannelTest, Emplace)
+{
+    msd::channel<wide> queue_channel{2};
+    emplace_without_moves(queue_channel);
+
+    msd::channel<wide, msd::vector_storage<wide>> vector_channel{2};
+    emplace_without_moves(vector_channel);
+
+    msd::channel<wide, msd::dynamic_ring_storage<wide>> dynamic_ring_channel{2};
+    emplace_without_moves(dynamic_ring_channel);
+
+    msd::channel<wide, msd::ring_storage<wide, 2>> ring_channel{};
+    emplace_without_moves(ring_channel);
+}
+
+TEST(ChannelTest, TryWriteAndTryRead)
+{
+    msd::channel<int> channel{2};
+
+    int out = 0;
+    EXPECT_EQ(channel.try_read(out), msd::channel_status::kEmpty);
+
+    EXPECT_EQ(channel.try_write(1), msd::channel_status::kOk);
+    const int in = 2;
+    EXPECT_EQ(channel.try_write(in), msd::channel_status::kOk);
+    EXPECT_EQ(channel.try_write(3), msd::channel_status::kFull);
+    EXPECT_EQ(channel.size(), 2);
+
+    EXPECT_EQ(channel.try_read(out), msd::channel_status::kOk);
+    EXPECT_EQ(out, 1);
+
+    channel.close();
+    EXPECT_EQ(channel.try_write(3), msd::channel_status::kClosed);
+
+    EXPECT_EQ(channel.try_read(out), msd::channel_status::kOk);
+    EXPECT_EQ(out, 2);
+    EXPECT_EQ(channel.try_read(out), msd::channel_status::kClosed);
+}
+
+TEST(ChannelTest, TimedWriteAndRead)
+{
+    msd::channel<int> channel{1};
+
+    int out = 0;
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(channel.read_for(out, std::chrono::milliseconds(20)), msd::channel_status::kTimeout);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+
+    EXPECT_EQ(channel.write_for(1, std::chrono::milliseconds(10)), msd::channel_status::kOk);
+    EXPECT_EQ(channel.write_for(2, std::chrono::milliseconds(20)), msd::channel_status::kTimeout);
+    EXPECT_EQ(channel.write_until(2, std::chrono::steady_clock::now() + std::chrono::milliseconds(1)),
+              msd::channel_status::kTimeout);
+
+    EXPECT_EQ(channel.read_for(out, std::chrono::milliseconds(10)), msd::channel_status::kOk);
+    EXPECT_EQ(out, 1);
+
+    std::thread writer{[&channel]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        channel.write(3);
+    }};
+    EXPECT_EQ(channel.read_until(out, std::chrono::steady_clock::now() + std::chrono::seconds(10)),
+              msd::channel_status::kOk);
+    EXPECT_EQ(out, 3);
+    writer.join();
+
+    channel.close();
+    EXPECT_EQ(channel.write_for(4, std::chrono::milliseconds(10)), msd::channel_status::kClosed);
+    EXPECT_EQ(channel.read_for(out, std::chrono::milliseconds(10)), msd::channel_status::kClosed);
+}
+
+template <typename Channel>
+void transfer_with_wait_strategy(Channel& channel)
+{
+    const int numbers = 1000;
+
+    std::thread writer{[&channel]() {
+        for (int i = 1; i <= numbers; ++i) {
+            channel << i;
+        }
+        channel.close();
+    }};
+
+    int expected = 1;
+    for (const int value : channel) {
+        EXPECT_EQ(value, expected);
+        ++expected;
+    }
+    EXPECT_EQ(expected, numbers + 1);
+
+    writer.join();
+}
+
+TEST(ChannelTest, WaitStrategies)
+{
+    msd::channel<int, msd::queue_storage<int>, msd::busy_wait> busy_channel{4};
+    transfer_with_wait_strategy(busy_channel);
+
+    msd::channel<int, msd::queue_storage<int>, msd::backoff_wait<>> backoff_channel{4};
+    transfer_with_wait_strategy(backoff_channel);
+
+    msd::static_channel<int, 4, msd::backoff_wait<0, 1>> yield_channel{};
+    transfer_with_wait_strategy(yield_channel);
+}
+
+TEST(ChannelTest, TimedReadWithBusyWait)
+{
+    msd::channel<int, msd::queue_storage<int>, msd::busy_wait> channel{1};
+
+    int out = 0;
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(channel.read_for(out, std::chrono::milliseconds(20)), msd::channel_status::kTimeout);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+
+    EXPECT_EQ(channel.write_for(1, std::chrono::milliseconds(10)), msd::channel_status::kOk);
+    EXPECT_EQ(channel.write_for(2, std::chrono::milliseconds(10)), msd::channel_status::kTimeout);
+
+    EXPECT_EQ(channel.read_for(out, std::chrono::milliseconds(10)), msd::channel_status::kOk);
+    EXPECT_EQ(out, 1);
+}
+
+TEST(ChannelTest, OnlySpinningStrategiesKeepSpinState)
+{
+    using blocking_channel = msd::channel<int, msd::queue_storage<int>, msd::blocking_wait>;
+    using busy_channel = msd::channel<int, msd::queue_storage<int>, msd::busy_wait>;
+
+    EXPECT_FALSE(msd::detail::strategy_spins<msd::blocking_wait>::value);
+    EXPECT_TRUE(msd::detail::strategy_spins<msd::busy_wait>::value);
+    EXPECT_TRUE((msd::detail::strategy_spins<msd::backoff_wait<>>::value));
+    EXPECT_LT(sizeof(blocking_channel), sizeof(busy_channel));
+}
+
+TEST(ChannelTest, SpinningReaderDoesNotHoldTheLock)
+{
+    msd::channel<int, msd::queue_storage<int>, msd::busy_wait, msd::channel_statistics> channel{1};
+
+    std::thread reader{[&channel]() {
+        int out = 0;
+        channel >> out;
+        EXPECT_EQ(out, 1);
+    }};
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    // The reader spins without the channel mutex, so other operations never find it locked
+    int out = 0;
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(channel.try_read(out), msd::channel_status::kEmpty);
+    }
+    channel << 1;
+    reader.join();
+
+    EXPECT_EQ(channel.statistics().contended_locks, 0);
+}
+
 TEST(ChannelTest, size)
 {
     msd::channel<int> channel;
@@ -201,6 +631,29 @@ TEST(ChannelTest, close)
     EXPECT_THROW(channel << std::move(in), msd::closed_channel);
 }
 
+TEST(ChannelTest, CloseUnblocksWaitingWriterAndReader)
+{
+    msd::channel<int> full{1};
+    full.write(1);
+
+    msd::channel<int> empty{1};
+
+    std::thread writer{[&full]() { EXPECT_FALSE(full.write(2)); }};
+    std::thread reader{[&empty]() {
+        int out = 0;
+        EXPECT_FALSE(empty.read(out));
+    }};
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    full.close();
+    empty.close();
+
+    writer.join();
+    reader.join();
+
+    EXPECT_EQ(full.size(), 1);
+}
+
 TEST(ChannelTest, drained)
 {
     msd::channel<int> channel;
@@ -0,0 +1,262 @@
+#include "msd/executor.hpp"
+
+#include <gtest/gtest.h>
+
+#include "msd/channel.hpp"
+#include "msd/static_channel.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Channel counting the non-blocking operations a stage attempts on it.
+template <typename T>
+class counting_channel : public msd::channel<T> {
+   public:
+    explicit counting_channel(const std::size_t capacity) : msd::channel<T>{capacity} {}
+
+    template <typename Type>
+    msd::channel_status try_write(Type&& value)
+    {
+        ++attempts;
+        return msd::channel<T>::try_write(std::forward<Type>(value));
+    }
+
+    msd::channel_status try_read(T& out)
+    {
+        ++attempts;
+        return msd::channel<T>::try_read(out);
+    }
+
+    std::atomic<int> attempts{0};
+};
+
+// Channel that cannot queue a read.
+template <typename T>
+class unqueueable_channel : public msd::channel<T> {
+   public:
+    explicit unqueueable_channel(const std::size_t capacity) : msd::channel<T>{capacity} {}
+
+    template <typename Handler>
+    void async_read(Handler&&)
+    {
+        throw std::runtime_error{"cannot queue"};
+    }
+};
+
+}  // namespace
+
+TEST(ExecutorTest, Threads)
+{
+    msd::executor two{2};
+    EXPECT_EQ(two.threads(), 2);
+
+    msd::executor at_least_one{0};
+    EXPECT_EQ(at_least_one.threads(), 1);
+
+    msd::executor per_core{};
+    EXPECT_GE(per_core.threads(), 1);
+}
+
+TEST(ExecutorTest, RunsPostedTasks)
+{
+    const int tasks = 1000;
+    std::atomic<int> count{0};
+
+    {
+        msd::executor executor{4};
+        for (int i = 0; i < tasks; ++i) {
+            executor.post([&count]() { ++count; });
+        }
+    }
+
+    EXPECT_EQ(count, tasks);
+}
+
+TEST(ExecutorTest, RunsTasksPostedFromWorkers)
+{
+    const int tasks = 100;
+    std::atomic<int> count{0};
+
+    {
+        msd::executor executor{2};
+        for (int i = 0; i < tasks; ++i) {
+            executor.post([&executor, &count]() {
+                executor.post([&count]() { ++count; });
+                ++count;
+            });
+        }
+    }
+
+    EXPECT_EQ(count, 2 * tasks);
+}
+
+TEST(ExecutorTest, ForEach)
+{
+    const int numbers = 1000;
+    msd::channel<int> input{10};
+
+    msd::executor executor{2};
+
+    std::atomic<std::int64_t> sum{0};
+    std::future<void> done = executor.for_each(input, [&sum](int value) { sum += value; }, 3);
+
+    for (int i = 1; i <= numbers; ++i) {
+        input.write(i);
+    }
+    input.close();
+
+    done.get();
+    EXPECT_EQ(sum, static_cast<std::int64_t>(numbers) * (numbers + 1) / 2);
+    EXPECT_TRUE(input.drained());
+}
+
+TEST(ExecutorTest, ForEachStoresException)
+{
+    msd::channel<int> input{10};
+    input.write(1);
+    input.write(2);
+    input.close();
+
+    msd::executor executor{1};
+    std::future<void> done = executor.for_each(input, [](int) { throw std::runtime_error{"error"}; });
+
+    EXPECT_THROW(done.get(), std::runtime_error);
+}
+
+TEST(ExecutorTest, Pipeline)
+{
+    const int numbers = 1000;
+
+    msd::channel<int> input{10};
+    msd::static_channel<std::string, 4> mapped{};
+    msd::channel<std::string> output{};
+
+    // A single worker runs all stages: full channels must not block it
+    msd::executor executor{1};
+
+    std::future<void> map =
+        executor.transform(input, mapped, [](int value) { return std::to_string(value * 2); }, 2);
+    std::future<void> copy = executor.transform(mapped, output, [](std::string value) { return value; });
+
+    std::thread producer{[&input]() {
+        for (int i = 1; i <= numbers; ++i) {
+            input.write(i);
+        }
+        input.close();
+    }};
+
+    std::int64_t sum = 0;
+    int count = 0;
+    for (const std::string& value : output) {
+        sum += std::stoi(value);
+        ++count;
+    }
+
+    producer.join();
+    map.get();
+    copy.get();
+
+    EXPECT_EQ(count, numbers);
+    EXPECT_EQ(sum, static_cast<std::int64_t>(numbers) * (numbers + 1));
+    EXPECT_TRUE(mapped.drained());
+    EXPECT_TRUE(output.drained());
+}
+
+TEST(ExecutorTest, StagesAndTasksShareWorkers)
+{
+    msd::channel<int> input{};
+    std::atomic<int> tasks{0};
+    std::atomic<int> elements{0};
+
+    {
+        msd::executor executor{2};
+        std::future<void> done = executor.for_each(input, [&elements](int) { ++elements; });
+
+        // Tasks still run while a stage waits for its input
+        for (int i = 0; i < 100; ++i) {
+            executor.post([&tasks]() { ++tasks; });
+        }
+        while (tasks < 100) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        input.write(1);
+        input.close();
+        done.get();
+    }
+
+    EXPECT_EQ(tasks, 100);
+    EXPECT_EQ(elements, 1);
+}
+
+TEST(ExecutorTest, WaitingStagesDoNotPoll)
+{
+    counting_channel<int> input{10};
+    counting_channel<int> output{1};
+
+    msd::executor executor{1};
+    std::future<void> done = executor.transform(input, output, [](int value) { return value; });
+
+    // The stage is queued on the empty input
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_LE(input.attempts, 2);
+
+    // The first result fills the output, the stage is queued on it with the second one
+    input.write(1);
+    input.write(2);
+    input.close();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_LE(output.attempts, 2);
+
+    int out = 0;
+    EXPECT_TRUE(output.read(out));
+    EXPECT_EQ(out, 1);
+    EXPECT_TRUE(output.read(out));
+    EXPECT_EQ(out, 2);
+
+    done.get();
+    EXPECT_TRUE(output.drained());
+}
+
+TEST(ExecutorTest, IdleStageIsNotRescheduled)
+{
+    counting_channel<int> input{10};
+
+    msd::executor executor{2};
+    std::future<void> done = executor.for_each(input, [](int) {}, 4);
+
+    // Each worker of the stage tries the empty input once, then is queued on it
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_LE(input.attempts, 4);
+
+    // The idle stage takes no worker from other tasks
+    std::promise<void> ran{};
+    executor.post([&ran]() { ran.set_value(); });
+    EXPECT_EQ(ran.get_future().wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    EXPECT_LE(input.attempts, 4);
+
+    input.close();
+    done.get();
+}
+
+TEST(ExecutorTest, StageThatCannotWaitFinishes)
+{
+    unqueueable_channel<int> input{10};
+
+    msd::executor executor{1};
+    std::future<void> done = executor.for_each(input, [](int) {});
+
+    EXPECT_THROW(done.get(), std::runtime_error);
+
+    // The executor does not wait for the failed stage when destroyed
+}
@@ -0,0 +1,138 @@
+#include "msd/latency.hpp"
+
+#include <gtest/gtest.h>
+
+#include "msd/channel.hpp"
+#include "msd/storage.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(LatencyTest, EmptyHistogram)
+{
+    const msd::latency_histogram histogram{};
+    const msd::latency_snapshot snapshot = histogram.snapshot();
+
+    EXPECT_EQ(snapshot.count, 0);
+    EXPECT_EQ(snapshot.p50().count(), 0);
+    EXPECT_EQ(snapshot.p999().count(), 0);
+    EXPECT_EQ(snapshot.max.count(), 0);
+}
+
+TEST(LatencyTest, Percentiles)
+{
+    msd::latency_histogram histogram{};
+
+    // 990 fast values, 9 slow, 1 very slow
+    for (int i = 0; i < 990; ++i) {
+        histogram.record(std::chrono::nanoseconds{100});
+    }
+    for (int i = 0; i < 9; ++i) {
+        histogram.record(std::chrono::microseconds{100});
+    }
+    histogram.record(std::chrono::milliseconds{10});
+    histogram.record(std::chrono::nanoseconds{-1});
+
+    const msd::latency_snapshot snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.count, 1001);
+    EXPECT_EQ(snapshot.max, std::chrono::milliseconds{10});
+    EXPECT_EQ(snapshot.sum, std::chrono::nanoseconds{990 * 100 + 9 * 100000 + 10000000});
+
+    // Upper bound of the power-of-two bucket
+    EXPECT_EQ(snapshot.p50(), std::chrono::nanoseconds{127});
+    EXPECT_EQ(snapshot.p99(), std::chrono::nanoseconds{127});
+    EXPECT_EQ(snapshot.p999(), std::chrono::nanoseconds{131071});
+    EXPECT_EQ(snapshot.percentile(1.0), std::chrono::milliseconds{10});
+    EXPECT_EQ(snapshot.percentile(0.0), std::chrono::nanoseconds{0});
+}
+
+TEST(LatencyTest, ScrapeAndReset)
+{
+    msd::latency_histogram histogram{};
+    histogram.record(std::chrono::nanoseconds{10});
+    histogram.record(std::chrono::nanoseconds{20});
+
+    msd::latency_snapshot snapshot = histogram.scrape();
+    EXPECT_EQ(snapshot.count, 2);
+    EXPECT_EQ(snapshot.max.count(), 20);
+    EXPECT_EQ(histogram.snapshot().count, 0);
+
+    histogram.record(std::chrono::nanoseconds{5});
+    snapshot = histogram.scrape();
+    EXPECT_EQ(snapshot.count, 1);
+    EXPECT_EQ(snapshot.max.count(), 5);
+
+    histogram.record(std::chrono::nanoseconds{5});
+    histogram.reset();
+    EXPECT_EQ(histogram.snapshot().count, 0);
+    EXPECT_EQ(histogram.snapshot().sum.count(), 0);
+}
+
+TEST(LatencyTest, ConcurrentRecordAndScrape)
+{
+    const int threads = 4;
+    const int records = 10000;
+    msd::latency_histogram histogram{};
+
+    std::vector<std::thread> writers{};
+    for (int t = 0; t < threads; ++t) {
+        writers.emplace_back([&histogram]() {
+            for (int i = 0; i < records; ++i) {
+                histogram.record(std::chrono::nanoseconds{i});
+            }
+        });
+    }
+
+    std::uint64_t scraped = 0;
+    for (int i = 0; i < 10; ++i) {
+        scraped += histogram.scrape().count;
+    }
+
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    scraped += histogram.scrape().count;
+
+    EXPECT_EQ(scraped, static_cast<std::uint64_t>(threads) * records);
+}
+
+TEST(LatencyTest, TimestampedStorage)
+{
+    msd::channel<std::string, msd::timestamped_storage<std::string>> chan{10};
+
+    chan << std::string{"a"};
+    EXPECT_TRUE(chan.emplace(std::size_t{2}, 'b'));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    std::string out{};
+    chan >> out;
+    EXPECT_EQ(out, "a");
+    EXPECT_TRUE(chan.consume([](const std::string& value) { EXPECT_EQ(value, "bb"); }));
+
+    const msd::latency_snapshot snapshot = chan.latency().scrape();
+    EXPECT_EQ(snapshot.count, 2);
+    EXPECT_GE(snapshot.p50(), std::chrono::milliseconds{20});
+    EXPECT_GE(snapshot.max, std::chrono::milliseconds{20});
+
+    EXPECT_EQ(chan.latency().snapshot().count, 0);
+}
+
+TEST(LatencyTest, TimestampedStaticStorage)
+{
+    using storage = msd::timestamped_storage<int, msd::ring_storage<msd::timestamped<int>, 4>>;
+    msd::channel<int, storage> chan{};
+
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(chan.try_write(i), msd::channel_status::kOk);
+    }
+    EXPECT_EQ(chan.try_write(4), msd::channel_status::kFull);
+
+    std::vector<int> values{};
+    EXPECT_EQ(chan.drain_into(values), 4);
+    EXPECT_EQ(values, (std::vector<int>{0, 1, 2, 3}));
+    EXPECT_EQ(chan.latency().snapshot().count, 4);
+}
@@ -0,0 +1,326 @@
+#include "msd/mpmc_channel.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+// Element whose assignment can be slowed down, to stall a writer between claiming a slot and publishing it.
+struct slow_element {
+    int value{};
+    bool slow{};
+
+    slow_element() = default;
+    slow_element(const int val, const bool is_slow) : value{val}, slow{is_slow} {}
+    slow_element(const slow_element&) = default;
+    slow_element(slow_element&&) = default;
+    ~slow_element() = default;
+
+    slow_element& operator=(const slow_element& other)
+    {
+        if (other.slow) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        value = other.value;
+        return *this;
+    }
+
+    slow_element& operator=(slow_element&& other) { return *this = static_cast<const slow_element&>(other); }
+};
+
+}  // namespace
+
+TEST(MpmcChannelTest, Traits)
+{
+    using type = int;
+    using channel = msd::mpmc_channel<type, 4>;
+    EXPECT_TRUE((std::is_same<channel::value_type, type>::value));
+
+    using iterator = msd::blocking_iterator<msd::mpmc_channel<type, 4>>;
+    EXPECT_TRUE((std::is_same<channel::iterator, iterator>::value));
+
+    EXPECT_TRUE((std::is_same<channel::size_type, std::size_t>::value));
+}
+
+TEST(MpmcChannelTest, WriteAndRead)
+{
+    msd::mpmc_channel<int, 4> channel;
+    EXPECT_TRUE(channel.empty());
+
+    int in = 1;
+    EXPECT_TRUE(channel.write(in));
+
+    const int cin = 3;
+    EXPECT_TRUE(channel.write(cin));
+    EXPECT_EQ(channel.size(), 2);
+
+    channel.close();
+    EXPECT_TRUE(channel.closed());
+    EXPECT_FALSE(channel.write(2));
+    EXPECT_FALSE(channel.drained());
+
+    int out = 0;
+
+    EXPECT_TRUE(channel.read(out));
+    EXPECT_EQ(1, out);
+
+    EXPECT_TRUE(channel.read(out));
+    EXPECT_EQ(3, out);
+
+    EXPECT_FALSE(channel.read(out));
+    EXPECT_TRUE(channel.drained());
+}
+
+TEST(MpmcChannelTest, PushAndFetch)
+{
+    msd::mpmc_channel<std::string, 2> channel;
+
+    std::string in{"abc"};
+    channel << std::move(in) << std::string{"def"};
+
+    std::string out{};
+    std::string out2{};
+    channel >> out >> out2;
+    EXPECT_EQ("abc", out);
+    EXPECT_EQ("def", out2);
+
+    channel.close();
+    EXPECT_THROW(channel << std::string{"ghi"}, msd::closed_channel);
+    EXPECT_NO_THROW(channel >> out);
+}
+
+TEST(MpmcChannelTest, TryWriteAndTryRead)
+{
+    msd::mpmc_channel<int, 2> channel;
+
+    int out = 0;
+    EXPECT_EQ(channel.try_read(out), msd::channel_status::kEmpty);
+
+    EXPECT_EQ(channel.try_write(1), msd::channel_status::kOk);
+    const int in = 2;
+    EXPECT_EQ(channel.try_write(in), msd::channel_status::kOk);
+    EXPECT_EQ(channel.try_write(3), msd::channel_status::kFull);
+    EXPECT_EQ(channel.size(), 2);
+
+    EXPECT_EQ(channel.try_read(out), msd::channel_status::kOk);
+    EXPECT_EQ(out, 1);
+
+    channel.close();
+    EXPECT_EQ(channel.try_write(3), msd::channel_status::kClosed);
+
+    EXPECT_EQ(channel.try_read(out), msd::channel_status::kOk);
+    EXPECT_EQ(out, 2);
+    EXPECT_EQ(channel.try_read(out), msd::channel_status::kClosed);
+}
+
+TEST(MpmcChannelTest, TimedWriteAndRead)
+{
+    msd::mpmc_channel<int, 2> channel;
+
+    int out = 0;
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(channel.read_for(out, std::chrono::milliseconds(20)), msd::channel_status::kTimeout);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+
+    EXPECT_EQ(channel.write_for(1, std::chrono::milliseconds(10)), msd::channel_status::kOk);
+    EXPECT_EQ(channel.write_until(1, std::chrono::steady_clock::now()), msd::channel_status::kOk);
+    EXPECT_EQ(channel.write_for(2, std::chrono::milliseconds(20)), msd::channel_status::kTimeout);
+    EXPECT_EQ(channel.write_until(2, std::chrono::steady_clock::now() + std::chrono::milliseconds(1)),
+              msd::channel_status::kTimeout);
+
+    EXPECT_EQ(channel.read_for(out, std::chrono::milliseconds(10)), msd::channel_status::kOk);
+    EXPECT_EQ(channel.read_until(out, std::chrono::steady_clock::now()), msd::channel_status::kOk);
+    EXPECT_EQ(out, 1);
+
+    std::thread writer{[&channel]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        channel.write(3);
+    }};
+    EXPECT_EQ(channel.read_until(out, std::chrono::steady_clock::now() + std::chrono::seconds(10)),
+              msd::channel_status::kOk);
+    EXPECT_EQ(out, 3);
+    writer.join();
+
+    channel.close();
+    EXPECT_EQ(channel.write_for(4, std::chrono::milliseconds(10)), msd::channel_status::kClosed);
+    EXPECT_EQ(channel.read_for(out, std::chrono::milliseconds(10)), msd::channel_status::kClosed);
+}
+
+TEST(MpmcChannelTest, MovableOnly)
+{
+    msd::mpmc_channel<std::unique_ptr<int>, 2> channel;
+
+    channel.write(std::unique_ptr<int>(new int(123)));
+
+    std::unique_ptr<int> out;
+    channel.read(out);
+
+    EXPECT_TRUE(out);
+    EXPECT_EQ(*out, 123);
+}
+
+TEST(MpmcChannelTest, CloseUnblocksWritersAndReaders)
+{
+    msd::mpmc_channel<int, 2> full;
+    full.write(1);
+    full.write(2);
+
+    msd::mpmc_channel<int, 2> empty;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 3; ++i) {
+        threads.emplace_back([&full]() { EXPECT_FALSE(full.write(3)); });
+        threads.emplace_back([&empty]() {
+            int out = 0;
+            EXPECT_FALSE(empty.read(out));
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    full.close();
+    empty.close();
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(full.size(), 2);
+}
+
+TEST(MpmcChannelTest, MultipleWritersAndReaders)
+{
+    const int numbers = 10000;
+    const std::int64_t expected_sum = 50005000;
+    constexpr int writers_count = 4;
+    constexpr int readers_count = 4;
+
+    msd::mpmc_channel<int, 8> channel;
+    std::atomic<std::int64_t> sum{0};
+    std::atomic<std::int64_t> nums{0};
+    std::atomic<int> writers_left{writers_count};
+
+    std::vector<std::thread> writers;
+    for (int w = 0; w < writers_count; ++w) {
+        writers.emplace_back([&, w]() {
+            for (int i = w + 1; i <= numbers; i += writers_count) {
+                channel << i;
+            }
+
+            if (--writers_left == 0) {
+                channel.close();
+            }
+        });
+    }
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < readers_count; ++r) {
+        readers.emplace_back([&]() {
+            for (auto value : channel) {
+                sum += value;
+                ++nums;
+            }
+        });
+    }
+
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(sum, expected_sum);
+    EXPECT_EQ(nums, numbers);
+    EXPECT_TRUE(channel.drained());
+}
+
+TEST(MpmcChannelTest, OutOfOrderWriteWakesReaders)
+{
+    msd::mpmc_channel<slow_element, 4> channel;
+    std::atomic<int> read{0};
+    const auto start = std::chrono::steady_clock::now();
+
+    // Two readers park on the empty channel
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 2; ++i) {
+        readers.emplace_back([&]() {
+            slow_element out{};
+            if (channel.read_for(out, std::chrono::seconds(5)) == msd::channel_status::kOk) {
+                ++read;
+            }
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    // The first write claims the first slot and stalls, the second one is published first
+    std::thread slow_writer{[&channel]() { channel.write(slow_element{1, true}); }};
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    channel.write(slow_element{2, false});
+
+    slow_writer.join();
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    // A reader missing its wakeup would only see the second element when its wait times out
+    EXPECT_EQ(read, 2);
+    const auto elapsed =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    EXPECT_LT(elapsed.count(), 2000);
+    EXPECT_TRUE(channel.empty());
+}
+
+TEST(MpmcChannelTest, ParkedWritersAndReadersAreAllWoken)
+{
+    // Writers and readers finish out of order on a tiny channel, so most of them park on a slot another thread is
+    // still filling or emptying. The channel is never closed: a lost wakeup leaves a thread parked until the deadline.
+    constexpr int writers_count = 4;
+    constexpr int readers_count = 4;
+    constexpr int per_thread = 5000;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+
+    msd::mpmc_channel<int, 2> channel;
+    std::atomic<std::int64_t> sum{0};
+    std::atomic<int> timeouts{0};
+
+    std::vector<std::thread> threads;
+    for (int w = 0; w < writers_count; ++w) {
+        threads.emplace_back([&]() {
+            for (int i = 1; i <= per_thread; ++i) {
+                if (channel.write_until(i, deadline) != msd::channel_status::kOk) {
+                    ++timeouts;
+                }
+            }
+        });
+    }
+    for (int r = 0; r < readers_count; ++r) {
+        threads.emplace_back([&]() {
+            int out = 0;
+            for (int i = 0; i < per_thread; ++i) {
+                if (channel.read_until(out, deadline) == msd::channel_status::kOk) {
+                    sum += out;
+                }
+                else {
+                    ++timeouts;
+                }
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(timeouts, 0);
+    EXPECT_EQ(sum, std::int64_t{writers_count} * per_thread * (per_thread + 1) / 2);
+    EXPECT_TRUE(channel.empty());
+}
@@ -0,0 +1,249 @@
+#include "msd/rendezvous_channel.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+TEST(RendezvousChannelTest, Traits)
+{
+    using type = int;
+    using channel = msd::rendezvous_channel<type>;
+    EXPECT_TRUE((std::is_same<channel::value_type, type>::value));
+
+    using iterator = msd::blocking_iterator<msd::rendezvous_channel<type>>;
+    EXPECT_TRUE((std::is_same<channel::iterator, iterator>::value));
+
+    EXPECT_TRUE((std::is_same<channel::size_type, std::size_t>::value));
+}
+
+TEST(RendezvousChannelTest, WriteBlocksUntilRead)
+{
+    msd::rendezvous_channel<int> channel;
+    std::atomic<bool> written{false};
+
+    std::thread writer{[&channel, &written]() {
+        EXPECT_TRUE(channel.write(1));
+        written = true;
+    }};
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(written);
+
+    int out = 0;
+    EXPECT_TRUE(channel.read(out));
+    EXPECT_EQ(out, 1);
+
+    writer.join();
+    EXPECT_TRUE(written);
+}
+
+TEST(RendezvousChannelTest, ReadBlocksUntilWrite)
+{
+    msd::rendezvous_channel<std::string> channel;
+
+    std::thread reader{[&channel]() {
+        std::string out{};
+        channel >> out;
+        EXPECT_EQ(out, "abc");
+    }};
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    channel << std::string{"abc"};
+
+    reader.join();
+}
+
+TEST(RendezvousChannelTest, TryWriteAndTryRead)
+{
+    msd::rendezvous_channel<int> channel;
+
+    int out = 0;
+    EXPECT_EQ(channel.try_read(out), msd::channel_status::kEmpty);
+    EXPECT_EQ(channel.try_write(1), msd::channel_status::kFull);
+
+    std::thread writer{[&channel]() { EXPECT_TRUE(channel.write(2)); }};
+    while (channel.try_read(out) != msd::channel_status::kOk) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(out, 2);
+    writer.join();
+
+    std::thread reader{[&channel]() {
+        int value = 0;
+        EXPECT_TRUE(channel.read(value));
+        EXPECT_EQ(value, 3);
+    }};
+    const int in = 3;
+    while (channel.try_write(in) != msd::channel_status::kOk) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    reader.join();
+
+    channel.close();
+    EXPECT_EQ(channel.try_write(4), msd::channel_status::kClosed);
+    EXPECT_EQ(channel.try_read(out), msd::channel_status::kClosed);
+}
+
+TEST(RendezvousChannelTest, TimedWriteAndRead)
+{
+    msd::rendezvous_channel<int> channel;
+
+    int out = 0;
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(channel.read_for(out, std::chrono::milliseconds(20)), msd::channel_status::kTimeout);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+
+    EXPECT_EQ(channel.write_for(1, std::chrono::milliseconds(10)), msd::channel_status::kTimeout);
+
+    std::thread writer{[&channel]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        channel.write(2);
+    }};
+    EXPECT_EQ(channel.read_until(out, std::chrono::steady_clock::now() + std::chrono::seconds(10)),
+              msd::channel_status::kOk);
+    EXPECT_EQ(out, 2);
+    writer.join();
+
+    std::thread reader{[&channel]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        int value = 0;
+        channel.read(value);
+        EXPECT_EQ(value, 3);
+    }};
+    EXPECT_EQ(channel.write_for(3, std::chrono::seconds(10)), msd::channel_status::kOk);
+    reader.join();
+
+    channel.close();
+    EXPECT_EQ(channel.write_for(4, std::chrono::milliseconds(10)), msd::channel_status::kClosed);
+    EXPECT_EQ(channel.read_for(out, std::chrono::milliseconds(10)), msd::channel_status::kClosed);
+}
+
+struct move_counter {
+    static int moves;
+
+    move_counter() = default;
+    move_counter(const move_counter&) = default;
+    move_counter& operator=(const move_counter&) = default;
+    move_counter(move_counter&&) noexcept { ++moves; }
+    move_counter& operator=(move_counter&&) noexcept
+    {
+        ++moves;
+        return *this;
+    }
+    ~move_counter() = default;
+};
+
+int move_counter::moves = 0;
+
+TEST(RendezvousChannelTest, SingleMovePerElement)
+{
+    msd::rendezvous_channel<move_counter> channel;
+
+    std::thread reader{[&channel]() {
+        move_counter out;
+        EXPECT_TRUE(channel.read(out));
+    }};
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_TRUE(channel.write(move_counter{}));
+    reader.join();
+
+    EXPECT_EQ(move_counter::moves, 1);
+
+    std::thread writer{[&channel]() { EXPECT_TRUE(channel.write(move_counter{})); }};
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    move_counter out;
+    EXPECT_TRUE(channel.read(out));
+    writer.join();
+
+    EXPECT_EQ(move_counter::moves, 2);
+}
+
+TEST(RendezvousChannelTest, MovableOnly)
+{
+    msd::rendezvous_channel<std::unique_ptr<int>> channel;
+
+    std::thread writer{[&channel]() { channel.write(std::unique_ptr<int>(new int(123))); }};
+
+    std::unique_ptr<int> out;
+    channel.read(out);
+    writer.join();
+
+    EXPECT_TRUE(out);
+    EXPECT_EQ(*out, 123);
+}
+
+TEST(RendezvousChannelTest, CloseUnblocksWriterAndReader)
+{
+    msd::rendezvous_channel<int> channel;
+
+    std::thread writer{[&channel]() {
+        const int in = 1;
+        EXPECT_FALSE(channel.write(in));
+    }};
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    channel.close();
+    writer.join();
+
+    EXPECT_TRUE(channel.closed());
+    EXPECT_TRUE(channel.drained());
+    EXPECT_THROW(channel << 2, msd::closed_channel);
+
+    msd::rendezvous_channel<int> other;
+    std::thread reader{[&other]() {
+        int out = 0;
+        EXPECT_FALSE(other.read(out));
+    }};
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    other.close();
+    reader.join();
+}
+
+TEST(RendezvousChannelTest, Multithreading)
+{
+    const int numbers = 1000;
+    const int writers = 4;
+    const std::int64_t expected_sum = writers * (static_cast<std::int64_t>(numbers) * (numbers + 1) / 2);
+
+    msd::rendezvous_channel<int> channel;
+
+    std::vector<std::thread> threads;
+    for (int w = 0; w < writers; ++w) {
+        threads.emplace_back([&channel]() {
+            for (int i = 1; i <= numbers; ++i) {
+                channel << i;
+            }
+        });
+    }
+
+    std::atomic<std::int64_t> sum{0};
+    std::atomic<int> count{0};
+    for (int r = 0; r < 2; ++r) {
+        threads.emplace_back([&channel, &sum, &count]() {
+            for (const int value : channel) {
+                sum += value;
+                ++count;
+            }
+        });
+    }
+
+    while (count < writers * numbers) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    channel.close();
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(sum, expected_sum);
+    EXPECT_EQ(count, writers * numbers);
+}
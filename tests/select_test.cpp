@@ -0,0 +1,214 @@
+#include "msd/select.hpp"
+
+#include <gtest/gtest.h>
+
+#include "msd/channel.hpp"
+#include "msd/static_channel.hpp"
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+TEST(SelectTest, ReadFromReadyChannel)
+{
+    msd::channel<int> numbers{10};
+    msd::static_channel<std::string, 2> strings{};
+
+    strings.write(std::string{"abc"});
+
+    int number = 0;
+    std::string str{};
+
+    msd::select sel;
+    sel.read(numbers, [&number](int value) { number = value; })
+        .read(strings, [&str](std::string value) { str = std::move(value); });
+
+    EXPECT_TRUE(sel.wait());
+    EXPECT_EQ(number, 0);
+    EXPECT_EQ(str, "abc");
+    EXPECT_TRUE(strings.empty());
+}
+
+TEST(SelectTest, WriteWhenThereIsSpace)
+{
+    msd::channel<int> full{1};
+    msd::channel<int> free{1};
+    full.write(1);
+
+    int written = 0;
+
+    msd::select sel;
+    sel.write(full, 2, [&written]() { written = 1; }).write(free, 3, [&written]() { written = 2; });
+
+    EXPECT_TRUE(sel.wait());
+    EXPECT_EQ(written, 2);
+
+    int out = 0;
+    free.read(out);
+    EXPECT_EQ(out, 3);
+    EXPECT_EQ(full.size(), 1);
+}
+
+TEST(SelectTest, BlocksUntilOneChannelIsReady)
+{
+    msd::channel<int> numbers{10};
+    msd::channel<std::string> strings{10};
+
+    std::thread writer{[&strings]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        strings.write(std::string{"abc"});
+    }};
+
+    std::string str{};
+
+    msd::select sel;
+    sel.read(numbers, [](int) { FAIL(); }).read(strings, [&str](std::string value) { str = std::move(value); });
+
+    EXPECT_TRUE(sel.wait());
+    EXPECT_EQ(str, "abc");
+
+    writer.join();
+}
+
+TEST(SelectTest, BlocksUntilWriteIsPossible)
+{
+    msd::channel<int> chan{1};
+    chan.write(1);
+
+    std::thread reader{[&chan]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        int out = 0;
+        chan.read(out);
+    }};
+
+    bool written = false;
+
+    msd::select sel;
+    sel.write(chan, 2, [&written]() { written = true; });
+
+    EXPECT_TRUE(sel.wait());
+    EXPECT_TRUE(written);
+
+    reader.join();
+
+    int out = 0;
+    chan.read(out);
+    EXPECT_EQ(out, 2);
+}
+
+TEST(SelectTest, Closed)
+{
+    msd::channel<int> data{10};
+    msd::channel<bool> shutdown{};
+
+    bool stopped = false;
+
+    msd::select sel;
+    sel.read(data, [](int) {}).read(shutdown, [](bool) {}, [&stopped]() { stopped = true; });
+
+    std::thread closer{[&shutdown]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        shutdown.close();
+    }};
+
+    EXPECT_TRUE(sel.wait());
+    EXPECT_TRUE(stopped);
+    closer.join();
+
+    // The shutdown case is disabled, the data case is still active
+    EXPECT_EQ(sel.wait_for(std::chrono::milliseconds(10)), msd::channel_status::kTimeout);
+
+    data.close();
+    EXPECT_FALSE(sel.wait());
+    EXPECT_EQ(sel.wait_for(std::chrono::milliseconds(10)), msd::channel_status::kClosed);
+}
+
+TEST(SelectTest, WaitForTimeout)
+{
+    msd::channel<int> chan{1};
+
+    msd::select sel;
+    sel.read(chan, [](int) {});
+
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(sel.wait_for(std::chrono::milliseconds(20)), msd::channel_status::kTimeout);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+
+    chan.write(1);
+    EXPECT_EQ(sel.wait_until(std::chrono::steady_clock::now() + std::chrono::seconds(10)), msd::channel_status::kOk);
+}
+
+TEST(SelectTest, NoCases)
+{
+    msd::select sel;
+    EXPECT_FALSE(sel.wait());
+}
+
+TEST(SelectTest, RandomizedChoice)
+{
+    msd::channel<int> first{};
+    msd::channel<int> second{};
+
+    int first_count = 0;
+    int second_count = 0;
+
+    msd::select sel;
+    sel.read(first, [&first_count](int) { ++first_count; }).read(second, [&second_count](int) { ++second_count; });
+
+    const int rounds = 1000;
+    for (int i = 0; i < rounds; ++i) {
+        first.write(1);
+        second.write(2);
+
+        EXPECT_TRUE(sel.wait());
+
+        int out = 0;
+        first.try_read(out);
+        second.try_read(out);
+    }
+
+    EXPECT_EQ(first_count + second_count, rounds);
+    EXPECT_GT(first_count, rounds / 4);
+    EXPECT_GT(second_count, rounds / 4);
+}
+
+TEST(SelectTest, Multithreading)
+{
+    const int numbers = 1000;
+
+    msd::channel<int> ints{5};
+    msd::channel<long> longs{5};
+
+    std::thread ints_writer{[&ints]() {
+        for (int i = 1; i <= numbers; ++i) {
+            ints.write(i);
+        }
+        ints.close();
+    }};
+    std::thread longs_writer{[&longs]() {
+        for (long i = 1; i <= numbers; ++i) {
+            longs.write(i);
+        }
+        longs.close();
+    }};
+
+    long sum = 0;
+    int count = 0;
+
+    const auto add = [&sum, &count](long value) {
+        sum += value;
+        ++count;
+    };
+
+    msd::select sel;
+    sel.read(ints, add).read(longs, add);
+
+    while (sel.wait()) {
+    }
+
+    ints_writer.join();
+    longs_writer.join();
+
+    EXPECT_EQ(count, 2 * numbers);
+    EXPECT_EQ(sum, 2L * numbers * (numbers + 1) / 2);
+}
@@ -0,0 +1,206 @@
+#include "msd/sharded_channel.hpp"
+
+#include <gtest/gtest.h>
+
+#include "msd/storage.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+TEST(ShardedChannelTest, Traits)
+{
+    using type = int;
+    using channel = msd::sharded_channel<type>;
+    EXPECT_TRUE((std::is_same<channel::value_type, type>::value));
+
+    using iterator = msd::blocking_iterator<msd::sharded_channel<type>>;
+    EXPECT_TRUE((std::is_same<channel::iterator, iterator>::value));
+
+    EXPECT_TRUE((std::is_same<channel::size_type, std::size_t>::value));
+}
+
+TEST(ShardedChannelTest, Shards)
+{
+    msd::sharded_channel<int> channel{4};
+    EXPECT_EQ(channel.shards(), 4);
+
+    msd::sharded_channel<int> at_least_one{0};
+    EXPECT_EQ(at_least_one.shards(), 1);
+
+    msd::sharded_channel<int> per_core{};
+    EXPECT_GE(per_core.shards(), 1);
+
+    msd::sharded_channel<int, msd::array_storage<int, 2>> static_shards{3};
+    EXPECT_EQ(static_shards.shards(), 3);
+}
+
+TEST(ShardedChannelTest, WriteAndReadInOrderFromOneThread)
+{
+    msd::sharded_channel<std::string> channel{4};
+
+    channel << std::string{"a"} << std::string{"b"};
+    EXPECT_TRUE(channel.write(std::string{"c"}));
+    EXPECT_EQ(channel.size(), 3);
+    EXPECT_FALSE(channel.empty());
+
+    std::string out{};
+    channel >> out;
+    EXPECT_EQ(out, "a");
+    EXPECT_TRUE(channel.read(out));
+    EXPECT_EQ(out, "b");
+    EXPECT_EQ(channel.try_read(out), msd::channel_status::kOk);
+    EXPECT_EQ(out, "c");
+
+    EXPECT_EQ(channel.try_read(out), msd::channel_status::kEmpty);
+    EXPECT_TRUE(channel.empty());
+}
+
+TEST(ShardedChannelTest, SpillsToOtherShardsWhenHomeIsFull)
+{
+    msd::sharded_channel<int> channel{3, 1};
+
+    EXPECT_EQ(channel.try_write(1), msd::channel_status::kOk);
+    EXPECT_EQ(channel.try_write(2), msd::channel_status::kOk);
+    EXPECT_EQ(channel.try_write(3), msd::channel_status::kOk);
+    EXPECT_EQ(channel.try_write(4), msd::channel_status::kFull);
+    EXPECT_EQ(channel.write_for(4, std::chrono::milliseconds(10)), msd::channel_status::kTimeout);
+    EXPECT_EQ(channel.size(), 3);
+
+    int sum = 0;
+    int out = 0;
+    while (channel.try_read(out) == msd::channel_status::kOk) {
+        sum += out;
+    }
+    EXPECT_EQ(sum, 6);
+}
+
+TEST(ShardedChannelTest, StealsFromOtherShards)
+{
+    msd::sharded_channel<int> channel{4};
+
+    // Each writer thread may have a different home shard
+    std::vector<std::thread> writers;
+    for (int i = 1; i <= 4; ++i) {
+        writers.emplace_back([&channel, i]() { channel.write(i); });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+
+    int sum = 0;
+    int out = 0;
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(channel.try_read(out), msd::channel_status::kOk);
+        sum += out;
+    }
+    EXPECT_EQ(sum, 10);
+    EXPECT_EQ(channel.try_read(out), msd::channel_status::kEmpty);
+}
+
+TEST(ShardedChannelTest, ReadBlocksUntilWrite)
+{
+    msd::sharded_channel<int> channel{4};
+
+    std::thread writer{[&channel]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        channel.write(1);
+    }};
+
+    int out = 0;
+    EXPECT_TRUE(channel.read(out));
+    EXPECT_EQ(out, 1);
+    writer.join();
+
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(channel.read_for(out, std::chrono::milliseconds(20)), msd::channel_status::kTimeout);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+}
+
+TEST(ShardedChannelTest, Close)
+{
+    msd::sharded_channel<int> channel{2};
+    channel.write(1);
+
+    std::thread reader{[&channel]() {
+        int out = 0;
+        EXPECT_TRUE(channel.read(out));
+        EXPECT_EQ(out, 1);
+        EXPECT_FALSE(channel.read(out));
+    }};
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    channel.close();
+    reader.join();
+
+    EXPECT_TRUE(channel.closed());
+    EXPECT_TRUE(channel.drained());
+    EXPECT_FALSE(channel.write(2));
+    EXPECT_EQ(channel.try_write(2), msd::channel_status::kClosed);
+    EXPECT_THROW(channel << 2, msd::closed_channel);
+
+    int out = 0;
+    EXPECT_EQ(channel.try_read(out), msd::channel_status::kClosed);
+    EXPECT_EQ(channel.read_for(out, std::chrono::milliseconds(10)), msd::channel_status::kClosed);
+}
+
+TEST(ShardedChannelTest, MovableOnly)
+{
+    msd::sharded_channel<std::unique_ptr<int>> channel{2, 1};
+
+    channel.write(std::unique_ptr<int>(new int(123)));
+
+    std::unique_ptr<int> out;
+    channel.read(out);
+
+    EXPECT_TRUE(out);
+    EXPECT_EQ(*out, 123);
+}
+
+TEST(ShardedChannelTest, Multithreading)
+{
+    const int numbers = 10000;
+    const int writers = 4;
+    const int readers = 4;
+    const std::int64_t expected_sum = writers * (static_cast<std::int64_t>(numbers) * (numbers + 1) / 2);
+
+    msd::sharded_channel<int> channel{4, 16};
+
+    std::vector<std::thread> writer_threads;
+    for (int w = 0; w < writers; ++w) {
+        writer_threads.emplace_back([&channel]() {
+            for (int i = 1; i <= numbers; ++i) {
+                channel << i;
+            }
+        });
+    }
+
+    std::atomic<std::int64_t> sum{0};
+    std::atomic<int> count{0};
+    std::vector<std::thread> reader_threads;
+    for (int r = 0; r < readers; ++r) {
+        reader_threads.emplace_back([&channel, &sum, &count]() {
+            for (const int value : channel) {
+                sum += value;
+                ++count;
+            }
+        });
+    }
+
+    for (auto& thread : writer_threads) {
+        thread.join();
+    }
+    channel.close();
+    for (auto& thread : reader_threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(sum, expected_sum);
+    EXPECT_EQ(count, writers * numbers);
+    EXPECT_TRUE(channel.drained());
+}
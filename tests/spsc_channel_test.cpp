@@ -0,0 +1,332 @@
+#include "msd/spsc_channel.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+TEST(SpscChannelTest, Traits)
+{
+    using type = int;
+    using channel = msd::spsc_channel<type, 4>;
+    EXPECT_TRUE((std::is_same<channel::value_type, type>::value));
+
+    using iterator = msd::blocking_iterator<msd::spsc_channel<type, 4>>;
+    EXPECT_TRUE((std::is_same<channel::iterator, iterator>::value));
+
+    EXPECT_TRUE((std::is_same<channel::size_type, std::size_t>::value));
+}
+
+TEST(SpscChannelTest, WriteAndRead)
+{
+    msd::spsc_channel<int, 4> channel;
+    EXPECT_TRUE(channel.empty());
+
+    int in = 1;
+    EXPECT_TRUE(channel.write(in));
+
+    const int cin = 3;
+    EXPECT_TRUE(channel.write(cin));
+    EXPECT_EQ(channel.size(), 2);
+
+    channel.close();
+    EXPECT_TRUE(channel.closed());
+    EXPECT_FALSE(channel.write(2));
+    EXPECT_FALSE(channel.drained());
+
+    int out = 0;
+
+    EXPECT_TRUE(channel.read(out));
+    EXPECT_EQ(1, out);
+
+    EXPECT_TRUE(channel.read(out));
+    EXPECT_EQ(3, out);
+
+    EXPECT_FALSE(channel.read(out));
+    EXPECT_TRUE(channel.drained());
+}
+
+TEST(SpscChannelTest, PushAndFetch)
+{
+    msd::spsc_channel<std::string, 2> channel;
+
+    std::string in{"abc"};
+    channel << std::move(in) << std::string{"def"};
+
+    std::string out{};
+    std::string out2{};
+    channel >> out >> out2;
+    EXPECT_EQ("abc", out);
+    EXPECT_EQ("def", out2);
+
+    channel.close();
+    EXPECT_THROW(channel << std::string{"ghi"}, msd::closed_channel);
+    EXPECT_NO_THROW(channel >> out);
+}
+
+TEST(SpscChannelTest, TryWriteAndTryRead)
+{
+    msd::spsc_channel<int, 2> channel;
+
+    int out = 0;
+    EXPECT_EQ(channel.try_read(out), msd::channel_status::kEmpty);
+
+    EXPECT_EQ(channel.try_write(1), msd::channel_status::kOk);
+    const int in = 2;
+    EXPECT_EQ(channel.try_write(in), msd::channel_status::kOk);
+    EXPECT_EQ(channel.try_write(3), msd::channel_status::kFull);
+    EXPECT_EQ(channel.size(), 2);
+
+    EXPECT_EQ(channel.try_read(out), msd::channel_status::kOk);
+    EXPECT_EQ(out, 1);
+
+    channel.close();
+    EXPECT_EQ(channel.try_write(3), msd::channel_status::kClosed);
+
+    EXPECT_EQ(channel.try_read(out), msd::channel_status::kOk);
+    EXPECT_EQ(out, 2);
+    EXPECT_EQ(channel.try_read(out), msd::channel_status::kClosed);
+}
+
+TEST(SpscChannelTest, TimedWriteAndRead)
+{
+    msd::spsc_channel<int, 1> channel;
+
+    int out = 0;
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(channel.read_for(out, std::chrono::milliseconds(20)), msd::channel_status::kTimeout);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+
+    EXPECT_EQ(channel.write_for(1, std::chrono::milliseconds(10)), msd::channel_status::kOk);
+    EXPECT_EQ(channel.write_for(2, std::chrono::milliseconds(20)), msd::channel_status::kTimeout);
+    EXPECT_EQ(channel.write_until(2, std::chrono::steady_clock::now() + std::chrono::milliseconds(1)),
+              msd::channel_status::kTimeout);
+
+    EXPECT_EQ(channel.read_for(out, std::chrono::milliseconds(10)), msd::channel_status::kOk);
+    EXPECT_EQ(out, 1);
+
+    std::thread writer{[&channel]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        channel.write(3);
+    }};
+    EXPECT_EQ(channel.read_until(out, std::chrono::steady_clock::now() + std::chrono::seconds(10)),
+              msd::channel_status::kOk);
+    EXPECT_EQ(out, 3);
+    writer.join();
+
+    channel.close();
+    EXPECT_EQ(channel.write_for(4, std::chrono::milliseconds(10)), msd::channel_status::kClosed);
+    EXPECT_EQ(channel.read_for(out, std::chrono::milliseconds(10)), msd::channel_status::kClosed);
+}
+
+TEST(SpscChannelTest, ClaimCommitAcquireRelease)
+{
+    msd::spsc_channel<int, 4> channel;
+
+    msd::slot_range<int> slots = channel.claim(3);
+    ASSERT_EQ(slots.size(), 3);
+    slots[0] = 1;
+    slots[1] = 2;
+    EXPECT_TRUE(channel.commit(2));
+    EXPECT_EQ(channel.size(), 2);
+
+    msd::slot_range<int> ready = channel.acquire();
+    ASSERT_EQ(ready.size(), 2);
+    EXPECT_EQ(ready[0], 1);
+    EXPECT_EQ(ready[1], 2);
+    channel.release(1);
+    EXPECT_EQ(channel.size(), 1);
+
+    // Only the slots until the end of the buffer are contiguous
+    slots = channel.claim();
+    ASSERT_EQ(slots.size(), 2);
+    std::fill(slots.begin(), slots.end(), 3);
+    EXPECT_TRUE(channel.commit(slots.size()));
+
+    slots = channel.claim();
+    ASSERT_EQ(slots.size(), 1);
+    slots[0] = 4;
+    EXPECT_TRUE(channel.commit(1));
+
+    int out = 0;
+    EXPECT_TRUE(channel.read(out));
+    EXPECT_EQ(out, 2);
+
+    ready = channel.acquire(10);
+    ASSERT_EQ(ready.size(), 2);
+    EXPECT_EQ(ready[0], 3);
+    EXPECT_EQ(ready[1], 3);
+    channel.release(2);
+
+    slots = channel.claim();
+    ASSERT_EQ(slots.size(), 3);
+    channel.close();
+    EXPECT_FALSE(channel.commit(1));
+    EXPECT_TRUE(channel.claim().empty());
+
+    ready = channel.acquire();
+    ASSERT_EQ(ready.size(), 1);
+    EXPECT_EQ(ready[0], 4);
+    channel.release(1);
+
+    EXPECT_TRUE(channel.acquire().empty());
+    EXPECT_TRUE(channel.drained());
+}
+
+TEST(SpscChannelTest, ClaimAndAcquireMultithreading)
+{
+    const int numbers = 100000;
+
+    msd::spsc_channel<int, 64> channel;
+
+    std::thread writer{[&channel]() {
+        int next = 1;
+        while (next <= numbers) {
+            msd::slot_range<int> slots = channel.claim(static_cast<std::size_t>(numbers - next + 1));
+            for (int& slot : slots) {
+                slot = next++;
+            }
+            channel.commit(slots.size());
+        }
+        channel.close();
+    }};
+
+    int expected = 1;
+    for (msd::slot_range<int> ready = channel.acquire(); !ready.empty(); ready = channel.acquire()) {
+        for (const int value : ready) {
+            EXPECT_EQ(value, expected);
+            ++expected;
+        }
+        channel.release(ready.size());
+    }
+    writer.join();
+
+    EXPECT_EQ(expected, numbers + 1);
+}
+
+TEST(SpscChannelTest, MovableOnly)
+{
+    msd::spsc_channel<std::unique_ptr<int>, 1> channel;
+
+    channel.write(std::unique_ptr<int>(new int(123)));
+
+    std::unique_ptr<int> out;
+    channel.read(out);
+
+    EXPECT_TRUE(out);
+    EXPECT_EQ(*out, 123);
+}
+
+TEST(SpscChannelTest, CloseUnblocksWriter)
+{
+    msd::spsc_channel<int, 1> channel;
+    channel.write(1);
+
+    std::thread writer{[&channel]() { EXPECT_FALSE(channel.write(2)); }};
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    channel.close();
+    writer.join();
+
+    EXPECT_EQ(channel.size(), 1);
+}
+
+TEST(SpscChannelTest, CloseUnblocksReader)
+{
+    msd::spsc_channel<int, 1> channel;
+
+    std::thread reader{[&channel]() {
+        int out = 0;
+        EXPECT_FALSE(channel.read(out));
+    }};
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    channel.close();
+    reader.join();
+}
+
+TEST(SpscChannelTest, ReadWriteClose)
+{
+    const int numbers = 100000;
+    const std::int64_t expected_sum = 5000050000;
+
+    msd::spsc_channel<int, 16> channel;
+
+    std::thread writer{[&channel]() {
+        for (int i = 1; i <= numbers; ++i) {
+            channel << i;
+        }
+        channel.close();
+    }};
+
+    std::int64_t sum = 0;
+    std::int64_t nums = 0;
+    int previous = 0;
+    for (auto value : channel) {
+        EXPECT_EQ(value, previous + 1);
+        previous = value;
+
+        sum += value;
+        ++nums;
+    }
+
+    writer.join();
+
+    EXPECT_EQ(sum, expected_sum);
+    EXPECT_EQ(nums, numbers);
+}
+
+TEST(SpscChannelTest, PingPongParksBothSides)
+{
+    // Each side waits for the other on every round, so both park and are woken thousands of times. A lost wakeup
+    // leaves one side parked until its wait times out.
+    const int rounds = 2000;
+    const auto timeout = std::chrono::seconds(10);
+    const auto start = std::chrono::steady_clock::now();
+
+    msd::spsc_channel<int, 2> ping;
+    msd::spsc_channel<int, 2> pong;
+
+    std::thread echo{[&]() {
+        int value = 0;
+        for (int i = 0; i < rounds; ++i) {
+            EXPECT_EQ(ping.read_for(value, timeout), msd::channel_status::kOk);
+            EXPECT_EQ(pong.write_for(value + 1, timeout), msd::channel_status::kOk);
+        }
+    }};
+
+    int value = 0;
+    for (int i = 0; i < rounds; ++i) {
+        EXPECT_EQ(ping.write_for(value, timeout), msd::channel_status::kOk);
+        EXPECT_EQ(pong.read_for(value, timeout), msd::channel_status::kOk);
+    }
+    echo.join();
+
+    EXPECT_EQ(value, rounds);
+    const auto elapsed =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    EXPECT_LT(elapsed, timeout);
+}
+
+TEST(SpscChannelTest, CopyFromStandardAlgorithm)
+{
+    msd::spsc_channel<int, 8> channel;
+
+    std::thread writer{[&channel]() {
+        const std::vector<int> input{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+        std::copy(input.begin(), input.end(), msd::back_inserter(channel));
+        channel.close();
+    }};
+
+    std::vector<int> results;
+    std::copy(channel.begin(), channel.end(), std::back_inserter(results));
+    writer.join();
+
+    EXPECT_EQ(results, (std::vector<int>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10}));
+}
@@ -0,0 +1,123 @@
+#include "msd/statistics.hpp"
+
+#include <gtest/gtest.h>
+
+#include "msd/channel.hpp"
+#include "msd/select.hpp"
+#include "msd/static_channel.hpp"
+
+#include <chrono>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+template <typename T>
+using counted_channel = msd::channel<T, msd::queue_storage<T>, msd::blocking_wait, msd::channel_statistics>;
+
+}  // namespace
+
+TEST(StatisticsTest, DisabledAddsNoSize)
+{
+    EXPECT_TRUE(std::is_empty<msd::no_statistics>::value);
+    using without_statistics = msd::channel<int, msd::queue_storage<int>, msd::blocking_wait, msd::no_statistics>;
+    EXPECT_TRUE((std::is_same<msd::channel<int>, without_statistics>::value));
+    EXPECT_GE(sizeof(counted_channel<int>), sizeof(msd::channel<int>) + sizeof(msd::channel_statistics_snapshot));
+}
+
+TEST(StatisticsTest, CountsReadsAndWrites)
+{
+    counted_channel<int> chan{10};
+
+    chan << 1 << 2;
+    EXPECT_TRUE(chan.emplace(3));
+    EXPECT_EQ(chan.try_write(4), msd::channel_status::kOk);
+    const std::vector<int> range{5, 6};
+    EXPECT_EQ(chan.write(range.begin(), range.end()), 2);
+
+    int out{};
+    chan >> out;
+    EXPECT_EQ(chan.try_read(out), msd::channel_status::kOk);
+    EXPECT_TRUE(chan.consume([](int) {}));
+
+    std::vector<int> rest{};
+    EXPECT_EQ(chan.drain_into(rest), 3);
+
+    chan << 7;
+
+    const msd::channel_statistics_snapshot stats = chan.statistics();
+    EXPECT_EQ(stats.writes, 7);
+    EXPECT_EQ(stats.reads, 6);
+    EXPECT_EQ(stats.high_water_mark, 6);
+    EXPECT_EQ(stats.blocked_writes, 0);
+    EXPECT_EQ(stats.blocked_reads, 0);
+    EXPECT_EQ(stats.write_blocked_time.count(), 0);
+    EXPECT_EQ(stats.read_blocked_time.count(), 0);
+}
+
+TEST(StatisticsTest, CountsBlockedTime)
+{
+    counted_channel<int> chan{1};
+
+    int out{};
+    EXPECT_EQ(chan.read_for(out, std::chrono::milliseconds(10)), msd::channel_status::kTimeout);
+
+    chan << 1;
+    EXPECT_EQ(chan.write_for(2, std::chrono::milliseconds(10)), msd::channel_status::kTimeout);
+
+    std::thread writer{[&chan]() { chan << 2; }};
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    chan >> out;
+    writer.join();
+
+    const msd::channel_statistics_snapshot stats = chan.statistics();
+    EXPECT_EQ(stats.blocked_reads, 1);
+    EXPECT_GE(stats.read_blocked_time, std::chrono::milliseconds(10));
+    EXPECT_EQ(stats.blocked_writes, 2);
+    EXPECT_GE(stats.write_blocked_time, std::chrono::milliseconds(10));
+    EXPECT_EQ(stats.high_water_mark, 1);
+}
+
+TEST(StatisticsTest, CountsContention)
+{
+    counted_channel<int> chan{10};
+    chan << 1;
+
+    // The element is consumed with the channel locked, while another thread tries to write
+    std::thread writer{};
+    EXPECT_TRUE(chan.consume([&chan, &writer](int) {
+        writer = std::thread{[&chan]() { chan << 2; }};
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }));
+    writer.join();
+
+    EXPECT_GE(chan.statistics().contended_locks, 1);
+}
+
+TEST(StatisticsTest, SelectOnChannelWithStatistics)
+{
+    counted_channel<int> chan{1};
+    chan << 1;
+
+    int out{};
+    EXPECT_TRUE(msd::select{}.read(chan, [&out](int value) { out = value; }).wait());
+    EXPECT_EQ(out, 1);
+    EXPECT_EQ(chan.statistics().reads, 1);
+}
+
+TEST(StatisticsTest, StaticChannel)
+{
+    msd::static_channel<int, 2, msd::blocking_wait, msd::channel_statistics> chan{};
+    EXPECT_EQ(chan.try_write(1), msd::channel_status::kOk);
+    EXPECT_EQ(chan.try_write(2), msd::channel_status::kOk);
+    EXPECT_EQ(chan.try_write(3), msd::channel_status::kFull);
+
+    int out{};
+    chan >> out;
+
+    const msd::channel_statistics_snapshot stats = chan.statistics();
+    EXPECT_EQ(stats.writes, 2);
+    EXPECT_EQ(stats.reads, 1);
+    EXPECT_EQ(stats.high_water_mark, 2);
+}
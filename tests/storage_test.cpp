@@ -2,12 +2,18 @@
 
 #include <gtest/gtest.h>
 
+#include <cstddef>
+#include <functional>
 #include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
 
 template <typename Storage>
 class StorageTest : public ::testing::Test {};
 
-using StorageTypes = ::testing::Types<msd::queue_storage<int>, msd::vector_storage<int>>;
+using StorageTypes = ::testing::Types<msd::queue_storage<int>, msd::vector_storage<int>, msd::dynamic_ring_storage<int>,
+                                     msd::segmented_storage<int, 4>>;
 
 TYPED_TEST_SUITE(StorageTest, StorageTypes, );
 
@@ -30,11 +36,45 @@ TYPED_TEST(StorageTest, PushAndPop)
     EXPECT_EQ(storage.size(), 0);
 }
 
+TYPED_TEST(StorageTest, EmplaceBack)
+{
+    TypeParam storage{10};
+
+    storage.emplace_back(42);
+    storage.emplace_back();
+    EXPECT_EQ(storage.size(), 2);
+
+    int out{};
+    storage.pop_front(out);
+    EXPECT_EQ(out, 42);
+
+    storage.pop_front(out);
+    EXPECT_EQ(out, 0);
+}
+
+TYPED_TEST(StorageTest, FrontAndPop)
+{
+    TypeParam storage{10};
+
+    storage.push_back(1);
+    storage.push_back(2);
+
+    EXPECT_EQ(storage.front(), 1);
+    storage.front() = 3;
+    EXPECT_EQ(storage.front(), 3);
+    storage.pop_front();
+
+    EXPECT_EQ(storage.front(), 2);
+    storage.pop_front();
+    EXPECT_EQ(storage.size(), 0);
+}
+
 template <typename Storage>
 class StorageWithMovableOnlyTypeTest : public ::testing::Test {};
 
 using StorageWithMovableOnlyTypeTypes =
-    ::testing::Types<msd::queue_storage<std::unique_ptr<int>>, msd::vector_storage<std::unique_ptr<int>>>;
+    ::testing::Types<msd::queue_storage<std::unique_ptr<int>>, msd::vector_storage<std::unique_ptr<int>>,
+                     msd::dynamic_ring_storage<std::unique_ptr<int>>, msd::segmented_storage<std::unique_ptr<int>>>;
 
 TYPED_TEST_SUITE(StorageWithMovableOnlyTypeTest, StorageWithMovableOnlyTypeTypes, );
 
@@ -55,7 +95,49 @@ TYPED_TEST(StorageWithMovableOnlyTypeTest, PushAndPop)
 template <typename Storage>
 class StaticStorageTest : public ::testing::Test {};
 
-using StaticStorageTypes = ::testing::Types<msd::array_storage<std::unique_ptr<int>, 5>>;
+template <typename Storage>
+void expect_contiguous_front(Storage& storage)
+{
+    for (int i = 0; i < 3; ++i) {
+        storage.push_back(std::unique_ptr<int>(new int(i)));
+    }
+    storage.pop_front_n(2);
+    EXPECT_EQ(storage.size(), 1);
+
+    // The elements wrap around the end of the buffer
+    for (int i = 3; i < 6; ++i) {
+        storage.push_back(std::unique_ptr<int>(new int(i)));
+    }
+    EXPECT_EQ(storage.size(), 4);
+    EXPECT_LT(storage.front_contiguous(), 4);
+
+    int expected = 2;
+    while (storage.size() > 0) {
+        const std::size_t count = storage.front_contiguous();
+        const std::unique_ptr<int>* data = storage.front_data();
+        for (std::size_t i = 0; i < count; ++i) {
+            EXPECT_EQ(*data[i], expected);
+            ++expected;
+        }
+        storage.pop_front_n(count);
+    }
+    EXPECT_EQ(expected, 6);
+}
+
+TEST(RingStorageTest, ContiguousFront)
+{
+    msd::array_storage<std::unique_ptr<int>, 4> array{};
+    expect_contiguous_front(array);
+
+    msd::ring_storage<std::unique_ptr<int>, 4> ring{};
+    expect_contiguous_front(ring);
+
+    msd::dynamic_ring_storage<std::unique_ptr<int>> dynamic_ring{4};
+    expect_contiguous_front(dynamic_ring);
+}
+
+using StaticStorageTypes =
+    ::testing::Types<msd::array_storage<std::unique_ptr<int>, 5>, msd::ring_storage<std::unique_ptr<int>, 5>>;
 
 TYPED_TEST_SUITE(StaticStorageTest, StaticStorageTypes, );
 
@@ -74,3 +156,364 @@ TYPED_TEST(StaticStorageTest, PushAndPop)
     EXPECT_TRUE(out);
     EXPECT_EQ(*out, 123);
 }
+
+struct not_default_constructible {
+    explicit not_default_constructible(std::shared_ptr<int> ptr) : value{std::move(ptr)} {}
+
+    std::shared_ptr<int> value;
+};
+
+TEST(RingStorageTest, ConstructsAndDestroysElementsInPlace)
+{
+    const auto counter = std::make_shared<int>(0);
+
+    {
+        msd::ring_storage<not_default_constructible, 3> storage{};
+        EXPECT_EQ(counter.use_count(), 1);
+
+        not_default_constructible out{nullptr};
+        for (int i = 0; i < 10; ++i) {
+            storage.push_back(not_default_constructible{counter});
+            storage.push_back(not_default_constructible{counter});
+            EXPECT_EQ(storage.size(), 2);
+            EXPECT_EQ(counter.use_count(), 3);
+
+            storage.pop_front(out);
+            EXPECT_EQ(counter.use_count(), 3);
+            storage.pop_front(out);
+            EXPECT_EQ(counter.use_count(), 2);
+            EXPECT_EQ(storage.size(), 0);
+
+            out.value.reset();
+        }
+
+        storage.push_back(not_default_constructible{counter});
+        storage.push_back(not_default_constructible{counter});
+        storage.push_back(not_default_constructible{counter});
+        EXPECT_EQ(storage.size(), 3);
+        EXPECT_EQ(counter.use_count(), 4);
+    }
+
+    EXPECT_EQ(counter.use_count(), 1);
+}
+
+TEST(DynamicRingStorageTest, WrapsAroundAndGrows)
+{
+    msd::dynamic_ring_storage<std::string> storage{0};
+
+    std::string out{};
+    for (int i = 0; i < 10; ++i) {
+        storage.push_back(std::to_string(i));
+        storage.pop_front(out);
+        EXPECT_EQ(out, std::to_string(i));
+    }
+
+    // Grows while the elements wrap around the end of the buffer
+    for (int i = 0; i < 100; ++i) {
+        storage.push_back(std::to_string(i));
+    }
+    EXPECT_EQ(storage.size(), 100);
+
+    for (int i = 0; i < 100; ++i) {
+        storage.pop_front(out);
+        EXPECT_EQ(out, std::to_string(i));
+    }
+    EXPECT_EQ(storage.size(), 0);
+}
+
+TEST(SegmentedStorageTest, GrowsAndShrinksAcrossSegments)
+{
+    const auto counter = std::make_shared<int>(0);
+
+    {
+        msd::segmented_storage<std::shared_ptr<int>, 3, 1> storage{0};
+
+        std::shared_ptr<int> out{};
+        int pushed = 0;
+        int popped = 0;
+        for (int round = 1; round <= 5; ++round) {
+            for (int i = 0; i < round * 4; ++i) {
+                storage.push_back(std::make_shared<int>(pushed++));
+            }
+            for (int i = 0; i < round * 3; ++i) {
+                storage.pop_front(out);
+                EXPECT_EQ(*out, popped++);
+            }
+            EXPECT_EQ(storage.size(), static_cast<std::size_t>(pushed - popped));
+        }
+
+        while (storage.size() > 0) {
+            storage.pop_front(out);
+            EXPECT_EQ(*out, popped++);
+        }
+        EXPECT_EQ(popped, pushed);
+
+        for (int i = 0; i < 10; ++i) {
+            storage.push_back(counter);
+        }
+        EXPECT_EQ(counter.use_count(), 11);
+    }
+
+    EXPECT_EQ(counter.use_count(), 1);
+}
+
+struct allocation_counter {
+    std::size_t allocations{0};
+    std::size_t live{0};
+};
+
+template <typename T>
+struct counting_allocator {
+    using value_type = T;
+
+    allocation_counter* counter;
+
+    explicit counting_allocator(allocation_counter* const cnt) noexcept : counter{cnt} {}
+
+    template <typename U>
+    counting_allocator(const counting_allocator<U>& other) noexcept : counter{other.counter}
+    {
+    }
+
+    T* allocate(const std::size_t count)
+    {
+        ++counter->allocations;
+        ++counter->live;
+        return std::allocator<T>{}.allocate(count);
+    }
+
+    void deallocate(T* const ptr, const std::size_t count) noexcept
+    {
+        --counter->live;
+        std::allocator<T>{}.deallocate(ptr, count);
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const counting_allocator<T>& lhs, const counting_allocator<U>& rhs) noexcept
+{
+    return lhs.counter == rhs.counter;
+}
+
+template <typename T, typename U>
+bool operator!=(const counting_allocator<T>& lhs, const counting_allocator<U>& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+template <typename Storage>
+class StorageWithAllocatorTest : public ::testing::Test {};
+
+using StorageWithAllocatorTypes =
+    ::testing::Types<msd::queue_storage<int, counting_allocator<int>>,
+                     msd::vector_storage<int, counting_allocator<int>>,
+                     msd::dynamic_ring_storage<int, counting_allocator<int>>,
+                     msd::segmented_storage<int, 4, 1, counting_allocator<int>>>;
+
+TYPED_TEST_SUITE(StorageWithAllocatorTest, StorageWithAllocatorTypes, );
+
+TYPED_TEST(StorageWithAllocatorTest, AllocatesWithAllocator)
+{
+    allocation_counter counter{};
+
+    {
+        TypeParam storage{0, counting_allocator<int>{&counter}};
+
+        for (int i = 0; i < 100; ++i) {
+            storage.push_back(i);
+        }
+        EXPECT_GT(counter.allocations, 0);
+
+        int out = 0;
+        for (int i = 0; i < 100; ++i) {
+            storage.pop_front(out);
+            EXPECT_EQ(out, i);
+        }
+        EXPECT_EQ(storage.size(), 0);
+    }
+
+    EXPECT_EQ(counter.live, 0);
+}
+
+TEST(SegmentedStorageTest, SteadyStateDoesNotAllocate)
+{
+    allocation_counter counter{};
+    msd::segmented_storage<int, 4, 2, counting_allocator<int>> storage{0, counting_allocator<int>{&counter}};
+
+    // The segment in use and the two retired ones hold 12 elements
+    const int retained = 12;
+    int out = 0;
+    for (int i = 0; i < retained; ++i) {
+        storage.push_back(i);
+    }
+    while (storage.size() > 0) {
+        storage.pop_front(out);
+    }
+    const std::size_t allocations = counter.allocations;
+
+    for (int cycle = 0; cycle < 1000; ++cycle) {
+        for (int i = 0; i < retained; ++i) {
+            storage.push_back(i);
+        }
+        for (int i = 0; i < retained; ++i) {
+            storage.pop_front(out);
+            EXPECT_EQ(out, i);
+        }
+    }
+
+    EXPECT_EQ(counter.allocations, allocations);
+}
+
+TEST(SegmentedStorageTest, KeepsAtMostMaxFreeSegments)
+{
+    allocation_counter counter{};
+
+    {
+        msd::segmented_storage<int, 4, 2, counting_allocator<int>> storage{0, counting_allocator<int>{&counter}};
+
+        for (int i = 0; i < 40; ++i) {
+            storage.push_back(i);
+        }
+        EXPECT_EQ(counter.live, 10);
+
+        int out = 0;
+        while (storage.size() > 0) {
+            storage.pop_front(out);
+        }
+
+        // The segment of the last element and two retired ones
+        EXPECT_EQ(counter.live, 3);
+    }
+
+    EXPECT_EQ(counter.live, 0);
+}
+
+struct throwing_element {
+    explicit throwing_element(const int val, const bool fail = false) : value{val}
+    {
+        if (fail) {
+            throw std::runtime_error{"cannot construct"};
+        }
+    }
+
+    int value;
+};
+
+TEST(SegmentedStorageTest, ThrowingConstructorLeavesStorageUnchanged)
+{
+    allocation_counter counter{};
+
+    {
+        using storage_type = msd::segmented_storage<throwing_element, 2, 1, counting_allocator<throwing_element>>;
+        storage_type storage{0, counting_allocator<throwing_element>{&counter}};
+
+        storage.emplace_back(1);
+        storage.emplace_back(2);
+
+        // The element would start a new segment
+        EXPECT_THROW(storage.emplace_back(3, true), std::runtime_error);
+        EXPECT_EQ(storage.size(), 2);
+
+        storage.pop_front();
+        storage.pop_front();
+        EXPECT_EQ(storage.size(), 0);
+
+        storage.emplace_back(4);
+        storage.emplace_back(5);
+        storage.emplace_back(6);
+        EXPECT_EQ(storage.front().value, 4);
+        storage.pop_front();
+        EXPECT_EQ(storage.front().value, 5);
+        storage.pop_front();
+        EXPECT_EQ(storage.front().value, 6);
+    }
+
+    EXPECT_EQ(counter.live, 0);
+}
+
+#ifdef MSD_CHANNEL_HAS_PMR
+TEST(PmrStorageTest, AllocatesFromMemoryResource)
+{
+    std::pmr::monotonic_buffer_resource resource{};
+    std::pmr::polymorphic_allocator<std::pmr::string> allocator{&resource};
+
+    msd::pmr::dynamic_ring_storage<std::pmr::string> storage{4, allocator};
+
+    // Elements are constructed with the storage's allocator (uses-allocator construction)
+    storage.emplace_back("a string long enough to not fit in the small string buffer");
+    EXPECT_EQ(storage.front().get_allocator().resource(), &resource);
+
+    std::pmr::string out{allocator};
+    storage.pop_front(out);
+    EXPECT_EQ(out, "a string long enough to not fit in the small string buffer");
+
+    msd::pmr::queue_storage<int> queue{0, &resource};
+    msd::pmr::vector_storage<int> vector{10, &resource};
+    msd::pmr::segmented_storage<int, 4> segmented{0, &resource};
+    for (int i = 0; i < 10; ++i) {
+        queue.push_back(i);
+        vector.push_back(i);
+        segmented.push_back(i);
+    }
+    EXPECT_EQ(queue.size(), 10);
+    EXPECT_EQ(vector.size(), 10);
+    EXPECT_EQ(segmented.size(), 10);
+}
+#endif
+
+TEST(PriorityStorageTest, HighestPriorityFirst)
+{
+    msd::priority_storage<int> storage{10};
+
+    for (const int value : {3, 1, 4, 1, 5, 9, 2, 6}) {
+        storage.push_back(value);
+    }
+    storage.emplace_back(7);
+    EXPECT_EQ(storage.size(), 9);
+    EXPECT_EQ(storage.front(), 9);
+
+    int out = 0;
+    for (const int expected : {9, 7, 6, 5, 4, 3, 2, 1}) {
+        storage.pop_front(out);
+        EXPECT_EQ(out, expected);
+    }
+    storage.pop_front();
+    EXPECT_EQ(storage.size(), 0);
+
+    msd::priority_storage<int, std::greater<int>> lowest_first{10};
+    lowest_first.push_back(2);
+    lowest_first.push_back(1);
+    lowest_first.pop_front(out);
+    EXPECT_EQ(out, 1);
+}
+
+struct prioritized {
+    int priority;
+    std::string name;
+};
+
+struct by_priority {
+    bool operator()(const prioritized& lhs, const prioritized& rhs) const { return lhs.priority < rhs.priority; }
+};
+
+TEST(StablePriorityStorageTest, FifoWithinEqualPriority)
+{
+    msd::stable_priority_storage<prioritized, by_priority> storage{10};
+
+    storage.push_back(prioritized{1, "bulk 1"});
+    storage.push_back(prioritized{1, "bulk 2"});
+    storage.push_back(prioritized{2, "urgent 1"});
+    storage.emplace_back(prioritized{1, "bulk 3"});
+    storage.push_back(prioritized{2, "urgent 2"});
+    EXPECT_EQ(storage.size(), 5);
+    EXPECT_EQ(storage.front().name, "urgent 1");
+
+    prioritized out{};
+    for (const char* expected : {"urgent 1", "urgent 2", "bulk 1", "bulk 2"}) {
+        storage.pop_front(out);
+        EXPECT_EQ(out.name, expected);
+    }
+
+    storage.pop_front();
+    EXPECT_EQ(storage.size(), 0);
+}